@@ -47,6 +47,9 @@ class Database {
   [[nodiscard]] meta::Meta* getMeta(meta_id_t meta_id);
   [[nodiscard]] const meta::Meta* getMeta(meta_id_t meta_id) const;
 
+  // Caches the canonical type of all types, done once at load.
+  void cacheCanonicalTypes();
+
  private:
   [[nodiscard]] meta_id_t reserveMetaId();
   void storeMeta(std::unique_ptr<meta::Meta> meta);
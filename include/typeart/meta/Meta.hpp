@@ -759,6 +759,9 @@ class Namespace final : public di::Scope {
 };
 
 class Type : public di::Scope {
+  // The result of strip_typedefs_and_qualifiers, if cached, see cache_canonical_type.
+  const di::Type* canonical_type = nullptr;
+
  protected:
   inline Type(meta_id_t id, Kind kind, std::vector<Meta*> refs) : di::Scope(id, kind, std::move(refs)) {
   }
@@ -814,8 +817,13 @@ class Type : public di::Scope {
 
   virtual size_t get_size_in_bits() const = 0;
 
+  // O(1) if the canonical type is cached, otherwise walks the chain of derived types.
   const di::Type& strip_typedefs_and_qualifiers() const;
 
+  // Caches the result of strip_typedefs_and_qualifiers. Must be called again if a base type within the
+  // chain of derived types changes.
+  void cache_canonical_type();
+
   virtual ~Type();
 };
 
@@ -302,6 +302,22 @@ class AccessRecorder {
     ++nullAndZeroAlloc;
   }
 
+  inline void incLookupCacheHit() {
+    ++lookupCacheHits;
+  }
+
+  inline void incLookupCacheMiss() {
+    ++lookupCacheMisses;
+  }
+
+  inline void incSubtypeMemoHit() {
+    ++subtypeMemoHits;
+  }
+
+  inline void incSubtypeMemoMiss() {
+    ++subtypeMemoMisses;
+  }
+
   inline void incOmpContextStack() {
     ++omp_stack;
   }
@@ -341,6 +357,18 @@ class AccessRecorder {
   Counter getAddrChecked() const {
     return addrChecked;
   }
+  Counter getLookupCacheHits() const {
+    return lookupCacheHits;
+  }
+  Counter getLookupCacheMisses() const {
+    return lookupCacheMisses;
+  }
+  Counter getSubtypeMemoHits() const {
+    return subtypeMemoHits;
+  }
+  Counter getSubtypeMemoMisses() const {
+    return subtypeMemoMisses;
+  }
   Counter getStackArray() const {
     return getStackArrayThreadStats().sum;
   }
@@ -472,23 +500,27 @@ class AccessRecorder {
   }
 
  private:
-  AtomicCounter heapAllocs       = 0;
-  AtomicCounter globalAllocs     = 0;
-  AtomicCounter maxHeapAllocs    = 0;
-  AtomicCounter curHeapAllocs    = 0;
-  AtomicCounter addrReuses       = 0;
-  AtomicCounter addrMissing      = 0;
-  AtomicCounter addrChecked      = 0;
-  AtomicCounter heapArray        = 0;
-  AtomicCounter globalArray      = 0;
-  AtomicCounter heapAllocsFree   = 0;
-  AtomicCounter heapArrayFree    = 0;
-  AtomicCounter nullAlloc        = 0;
-  AtomicCounter zeroAlloc        = 0;
-  AtomicCounter nullAndZeroAlloc = 0;
-  AtomicCounter omp_stack        = 0;
-  AtomicCounter omp_heap         = 0;
-  AtomicCounter omp_heap_free    = 0;
+  AtomicCounter heapAllocs        = 0;
+  AtomicCounter globalAllocs      = 0;
+  AtomicCounter maxHeapAllocs     = 0;
+  AtomicCounter curHeapAllocs     = 0;
+  AtomicCounter addrReuses        = 0;
+  AtomicCounter addrMissing       = 0;
+  AtomicCounter addrChecked       = 0;
+  AtomicCounter lookupCacheHits   = 0;
+  AtomicCounter lookupCacheMisses = 0;
+  AtomicCounter subtypeMemoHits   = 0;
+  AtomicCounter subtypeMemoMisses = 0;
+  AtomicCounter heapArray         = 0;
+  AtomicCounter globalArray       = 0;
+  AtomicCounter heapAllocsFree    = 0;
+  AtomicCounter heapArrayFree     = 0;
+  AtomicCounter nullAlloc         = 0;
+  AtomicCounter zeroAlloc         = 0;
+  AtomicCounter nullAndZeroAlloc  = 0;
+  AtomicCounter omp_stack         = 0;
+  AtomicCounter omp_heap          = 0;
+  AtomicCounter omp_heap_free     = 0;
 
   //  ThreadRecorderMapSafe threadRecorders;
   mutable MutexT threadRecorderMutex;
@@ -537,6 +569,14 @@ class NoneRecorder {
   }
   [[maybe_unused]] inline void incAddrMissing(const void*) {
   }
+  [[maybe_unused]] inline void incLookupCacheHit() {
+  }
+  [[maybe_unused]] inline void incLookupCacheMiss() {
+  }
+  [[maybe_unused]] inline void incSubtypeMemoHit() {
+  }
+  [[maybe_unused]] inline void incSubtypeMemoMiss() {
+  }
   [[maybe_unused]] inline void incStackFree(const meta::StackAllocation*, size_t) {
   }
   [[maybe_unused]] inline void incHeapFree(const meta::HeapAllocation*, size_t) {
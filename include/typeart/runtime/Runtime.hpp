@@ -17,8 +17,10 @@
 #include "AccessCounter.hpp"
 
 #include <cstddef>
+#include <cstdint>
 #include <result.hpp>
 #include <string>
+#include <vector>
 
 namespace typeart {
 
@@ -40,6 +42,9 @@ using pointer     = meta::pointer;
 using byte_size   = meta::byte_size;
 using byte_offset = meta::byte_offset;
 
+// The members accessed (outermost first) to reach a subtype.
+using member_path = std::vector<const meta::di::Member*>;
+
 class PointerInfo final {
   // The base address for the subrange this pointer info represents.
   meta::pointer base_addr = meta::pointer{nullptr};
@@ -95,6 +100,31 @@ class PointerInfo final {
     return get(pointer{addr});
   }
 
+  // Same as get, additionally stores the base address of the allocation containing addr in allocation_base (if
+  // the allocation is found).
+  static cpp::result<PointerInfo, Status> get(pointer addr, pointer& allocation_base);
+
+  // Same as get, additionally stores the generation the result is valid for in generation, i.e., the result remains
+  // valid as long as current_generation() returns the same value. Results which are never invalidated (errors, frames
+  // of the allocator stack) get the generation 0, which never matches, and must not be memoized by the caller.
+  // The base address of the containing allocation is stored in allocation_base, see is_unchanged_since.
+  static cpp::result<PointerInfo, Status> get_with_generation(pointer addr, std::uint64_t& generation,
+                                                              pointer& allocation_base);
+
+  // Bumped whenever an allocation whose lookup result may have been memoized is freed or changes.
+  static std::uint64_t current_generation();
+
+  // Returns true if the allocation beginning at allocation_base was neither freed nor changed since generation, both
+  // as stored by get_with_generation. Unlike comparing with current_generation, frees of other allocations mostly do
+  // not count. Always false for the generation 0.
+  static bool is_unchanged_since(pointer allocation_base, std::uint64_t generation);
+
+  // Queries n addresses at once, results[i] is the result for addrs[i]. Addresses which miss the lookup cache are
+  // resolved in address order with a single pass over the allocation map.
+  // If given, the base addresses of the containing allocations are stored in allocation_bases.
+  static void get_batch(const void* const* addrs, size_t n, cpp::result<PointerInfo, Status>* results,
+                        const void** allocation_bases = nullptr);
+
   inline pointer getBaseAddr() const {
     return base_addr;
   }
@@ -133,9 +163,33 @@ class PointerInfo final {
 
   cpp::result<PointerInfo, Status> findMember(byte_offset offset) const;
 
+  // Resolves the pointer info of addr within the range described by this instance, e.g., for another address of a
+  // buffer which was queried with get before, without looking up the allocation again.
+  // Returns Status::UNKNOWN_ADDRESS if addr is not within the range.
+  cpp::result<PointerInfo, Status> resolveAddr(pointer addr) const;
+
+  // Resolves the innermost (canonical) type at addr, equivalent to resolving the subtype of addr followed by
+  // resolveToInnermostType. Uses the flattened layout tables built at type database load, i.e., a single binary
+  // search per (array of) structure type instead of a member search per nesting level.
+  // Returns Status::BAD_ALIGNMENT if addr does not point to the beginning of an innermost element.
+  cpp::result<PointerInfo, Status> resolveOffsetFast(pointer addr) const;
+
+  // Same as resolveOffsetFast, additionally appends the members accessed from the type of this instance to the
+  // innermost type to path, e.g., the array member and the member within its element for an array of structures.
+  cpp::result<PointerInfo, Status> resolveOffsetFast(pointer addr, member_path& path) const;
+
  private:
+  // Same as get, additionally stores the generation of the (possibly cached) result, see get_with_generation.
+  static cpp::result<PointerInfo, Status> lookup(pointer addr, pointer& allocation_base, std::uint64_t& generation);
+  static cpp::result<PointerInfo, Status> resolveFound(pointer addr, const PointerInfo& pointer_info,
+                                                       std::uint64_t generation);
+
   cpp::result<Subrange, Status> getSubrange(pointer addr) const;
+  cpp::result<PointerInfo, Status> resolveOffset(pointer addr, member_path* path) const;
+  // Memoized per (canonical type, offset within the element), see SubtypeCache.
   cpp::result<PointerInfo, Status> resolveSubtype(pointer addr) const;
+  // If given, the members accessed to reach the subtype are appended to path.
+  cpp::result<PointerInfo, Status> resolveSubtypeUncached(pointer addr, member_path* path) const;
 };
 
 std::ostream& operator<<(std::ostream& os, const PointerInfo& pointer_info);
@@ -0,0 +1,68 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_RUNTIMEINTERFACE_H
+#define TYPEART_RUNTIMEINTERFACE_H
+
+#include "../meta/Meta.h"
+
+#ifdef __cplusplus
+#include <cstddef>
+#else
+#include <stddef.h>
+#endif
+
+// Query interface for tools which cannot use the C++ API (see Runtime.hpp)
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Same values as typeart::Status
+typedef enum typeart_status_t {
+  TYPEART_OK = 0,
+  TYPEART_UNKNOWN_ADDRESS,
+  TYPEART_BAD_ALIGNMENT,
+  TYPEART_OFFSET_OUT_OF_RANGE,
+  TYPEART_BAD_OFFSET,
+  TYPEART_WRONG_KIND,
+  TYPEART_INVALID_ALLOC_ID,
+  TYPEART_INVALID_META_ID,
+  TYPEART_UNSUPPORTED_TYPE
+} typeart_status;
+
+// Plain result of a query, owns no memory.
+typedef struct typeart_type_info_t {
+  // Base address of the allocation containing the queried address
+  const void* base_addr;
+  // Offset of the queried address w.r.t. base_addr in bytes
+  size_t offset;
+  // Meta id of the type at the queried address
+  meta_id_value type_id;
+  // Element count beginning at the queried address
+  size_t count;
+  // Size of one element of type_id in bytes
+  size_t element_size;
+} typeart_type_info;
+
+// Queries the type at addr. info is only written if TYPEART_OK is returned.
+// Does not allocate memory (except for logging of errors), i.e., may be used on hot paths of checkers.
+typeart_status typeart_get_type(const void* addr, typeart_type_info* info);
+
+// Queries n addresses at once, infos[i] and statuses[i] describe addrs[i]. infos[i] is only written if statuses[i] is
+// TYPEART_OK.
+void typeart_get_types(const void* const* addrs, size_t n, typeart_type_info* infos, typeart_status* statuses);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // TYPEART_RUNTIMEINTERFACE_H
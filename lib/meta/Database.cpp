@@ -55,6 +55,14 @@ const meta::Meta* Database::getMeta(meta_id_t meta_id) const {
   return meta_info[meta_id.value() - 1].get();
 }
 
+void Database::cacheCanonicalTypes() {
+  for (auto& meta : meta_info) {
+    if (auto* type = dyn_cast<di::Type>(meta.get()); type != nullptr) {
+      type->cache_canonical_type();
+    }
+  }
+}
+
 [[nodiscard]] meta_id_t Database::reserveMetaId() {
   auto result = meta_id_t{static_cast<meta_id_t::value_type>(meta_info.size() + 1)};
   meta_info.resize(result.value());
@@ -607,6 +607,9 @@ Type::~Type() {
 }
 
 const di::Type& Type::strip_typedefs_and_qualifiers() const {
+  if (canonical_type != nullptr) {
+    return *canonical_type;
+  }
   auto result = this;
   while (auto derived_type = dyn_cast<DerivedType>(result)) {
     switch (derived_type->get_tag()) {
@@ -629,6 +632,11 @@ const di::Type& Type::strip_typedefs_and_qualifiers() const {
   return *result;
 }
 
+void Type::cache_canonical_type() {
+  canonical_type = nullptr;
+  canonical_type = &strip_typedefs_and_qualifiers();
+}
+
 META_CLASS_IMPL(di::Type, VoidType,  //
                 (0, ()),             //
                 (0, ()))
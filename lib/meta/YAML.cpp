@@ -213,6 +213,7 @@ std::optional<Database> Database::load(const std::string& file) {
   auto meta_info_file = MetaInfoFile{0, db.meta_info};
   yaml::Input in(memBuffer.get()->getMemBufferRef(), &meta_info_file);
   in >> meta_info_file;
+  db.cacheCanonicalTypes();
   return db;
 }
 
@@ -0,0 +1,123 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "AsyncChecker.h"
+
+#include <utility>
+
+namespace typeart {
+
+CheckQueue::CheckQueue() : cells(std::make_unique<Cell[]>(check_queue::queue_size)) {
+  for (size_t i = 0; i < check_queue::queue_size; ++i) {
+    cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+bool CheckQueue::try_push(BufferCheck& check) {
+  auto pos = enqueue_pos.load(std::memory_order_relaxed);
+  for (;;) {
+    auto& cell          = cells[pos & (check_queue::queue_size - 1)];
+    const auto sequence = cell.sequence.load(std::memory_order_acquire);
+    const auto diff     = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        cell.check = std::move(check);
+        cell.sequence.store(pos + 1, std::memory_order_release);
+        return true;
+      }
+    } else if (diff < 0) {
+      return false;
+    } else {
+      pos = enqueue_pos.load(std::memory_order_relaxed);
+    }
+  }
+}
+
+bool CheckQueue::try_pop(BufferCheck& check) {
+  auto& cell          = cells[dequeue_pos & (check_queue::queue_size - 1)];
+  const auto sequence = cell.sequence.load(std::memory_order_acquire);
+  if (sequence != dequeue_pos + 1) {
+    return false;
+  }
+  check = std::move(cell.check);
+  cell.sequence.store(dequeue_pos + check_queue::queue_size, std::memory_order_release);
+  ++dequeue_pos;
+  return true;
+}
+
+void AsyncChecker::start(CheckFn check_fn) {
+  running.store(true, std::memory_order_release);
+  worker = std::thread([this, check_fn] { run(check_fn); });
+}
+
+void AsyncChecker::run(CheckFn check_fn) {
+  BufferCheck check;
+  for (;;) {
+    if (queue.try_pop(check)) {
+      check_fn(check);
+      check.mpi_type.reset();
+      completed.fetch_add(1);
+      if (flushing.load() > 0) {
+        std::lock_guard<std::mutex> guard(mutex);
+        work_done.notify_all();
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> guard(mutex);
+    // Sequentially consistent with the counters, such that submit either sees the helper thread idle or the helper
+    // thread sees the submitted check before it waits.
+    idle.store(true);
+    work_available.wait(guard, [this] { return completed.load() != submitted.load() || !running.load(); });
+    idle.store(false);
+    if (!running.load() && completed.load() == submitted.load()) {
+      return;
+    }
+  }
+}
+
+bool AsyncChecker::submit(BufferCheck& check) {
+  if (!is_running() || !queue.try_push(check)) {
+    return false;
+  }
+  submitted.fetch_add(1);
+  if (idle.load()) {
+    std::lock_guard<std::mutex> guard(mutex);
+    work_available.notify_one();
+  }
+  return true;
+}
+
+void AsyncChecker::flush() {
+  const auto target = submitted.load();
+  if (completed.load() >= target) {
+    return;
+  }
+  flushing.fetch_add(1);
+  {
+    std::unique_lock<std::mutex> guard(mutex);
+    work_done.wait(guard, [this, target] { return completed.load() >= target; });
+  }
+  flushing.fetch_sub(1);
+}
+
+void AsyncChecker::stop() {
+  if (!running.exchange(false)) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    work_available.notify_one();
+  }
+  worker.join();
+}
+
+}  // namespace typeart
@@ -0,0 +1,127 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_MPI_INTERCEPTOR_ASYNC_CHECKER_H
+#define TYPEART_MPI_INTERCEPTOR_ASYNC_CHECKER_H
+
+#include "Stats.h"
+#include "TypeCheck.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mpi.h>
+#include <mutex>
+#include <thread>
+
+namespace typeart {
+
+namespace check_queue {
+// Number of checks which may be pending at once, must be a power of two.
+constexpr size_t queue_size = 4096;
+
+static_assert(__builtin_popcountll(queue_size) == 1);
+}  // namespace check_queue
+
+// A buffer check of an intercepted call, with the buffer and the datatype already resolved. Holds everything the
+// type comparison needs, such that it does not depend on the buffer or the datatype handle to be still alive.
+struct BufferCheck {
+  const char* name{nullptr};
+  const void* called_from{nullptr};
+  bool is_send{false};
+  const void* ptr{nullptr};
+  int count{0};
+  MPI_Datatype type{MPI_DATATYPE_NULL};
+  CallSiteCounter* site{nullptr};
+  PointerInfo pointer_info{};
+  // See PointerInfo::get_with_generation and CallSiteCache::insert.
+  std::uint64_t generation{0};
+  std::uint64_t type_generation{0};
+  pointer allocation_base{nullptr};
+  std::shared_ptr<const MPIType> mpi_type{};
+};
+
+// A bounded, lock-free multi-producer single-consumer queue (a ring buffer of cells with sequence numbers).
+class CheckQueue {
+  struct Cell {
+    std::atomic_size_t sequence;
+    BufferCheck check;
+  };
+
+  std::unique_ptr<Cell[]> cells;
+  alignas(64) std::atomic_size_t enqueue_pos{0};
+  alignas(64) size_t dequeue_pos{0};
+
+ public:
+  CheckQueue();
+
+  // Moves from check only if it was pushed, returns false if the queue is full.
+  bool try_push(BufferCheck& check);
+
+  // Must only be called by the consumer.
+  bool try_pop(BufferCheck& check);
+};
+
+// Runs buffer checks of non-blocking calls on a helper thread, so that the calling thread only pushes to a queue.
+// The CallSiteCache is per thread, hence, the verdicts of asynchronous checks are never memoized (the calling thread
+// still gets hits for verdicts of its own synchronous checks).
+// The helper thread blocks while the queue is empty, submit only takes the mutex to wake it up if it waits.
+class AsyncChecker {
+ public:
+  using CheckFn = void (*)(const BufferCheck&);
+
+ private:
+  CheckQueue queue;
+  std::thread worker;
+  std::atomic_bool running{false};
+  std::atomic_size_t submitted{0};
+  std::atomic_size_t completed{0};
+  std::mutex mutex;
+  // Signalled by submit and stop, the helper thread waits for it.
+  std::condition_variable work_available;
+  // Signalled by the helper thread for each completed check while flush waits.
+  std::condition_variable work_done;
+  std::atomic_bool idle{false};
+  std::atomic_size_t flushing{0};
+
+  void run(CheckFn check_fn);
+
+ public:
+  AsyncChecker() = default;
+  AsyncChecker(const AsyncChecker&) = delete;
+  AsyncChecker& operator=(const AsyncChecker&) = delete;
+
+  ~AsyncChecker() {
+    stop();
+  }
+
+  void start(CheckFn check_fn);
+
+  // Returns false if the check was not submitted (queue full or not started), the caller must run it then.
+  bool submit(BufferCheck& check);
+
+  // Waits for all checks submitted so far.
+  void flush();
+
+  // Runs all pending checks and joins the helper thread.
+  void stop();
+
+  [[nodiscard]] bool is_running() const {
+    return running.load(std::memory_order_acquire);
+  }
+};
+
+}  // namespace typeart
+
+#endif  // TYPEART_MPI_INTERCEPTOR_ASYNC_CHECKER_H
@@ -0,0 +1,65 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "CallSiteCache.h"
+
+#include <atomic>
+
+namespace typeart {
+
+namespace {
+// Starts at 1 such that default constructed entries are never valid.
+std::atomic<std::uint64_t> type_generation{1};
+}  // namespace
+
+CallSiteCache& CallSiteCache::get() {
+  static thread_local CallSiteCache cache;
+  return cache;
+}
+
+void CallSiteCache::invalidate_types() {
+  type_generation.fetch_add(1);
+}
+
+std::uint64_t CallSiteCache::current_type_generation() {
+  return type_generation.load(std::memory_order_acquire);
+}
+
+const CallSiteVerdict* CallSiteCache::find(const void* called_from, const void* ptr, int count,
+                                           MPI_Datatype type) const {
+  const auto& entry = entries[index_for(called_from, ptr)];
+  if (entry.called_from != called_from || entry.ptr != ptr || entry.count != count || entry.type != type) {
+    return nullptr;
+  }
+  if (entry.type_generation != current_type_generation() ||
+      entry.generation != PointerInfo::current_generation()) {
+    return nullptr;
+  }
+  return &entry.verdict;
+}
+
+void CallSiteCache::insert(const void* called_from, const void* ptr, int count, MPI_Datatype type,
+                           std::uint64_t generation, std::uint64_t type_generation, const CallSiteVerdict& verdict) {
+  if (generation == 0) {
+    return;
+  }
+  auto& entry           = entries[index_for(called_from, ptr)];
+  entry.called_from     = called_from;
+  entry.ptr             = ptr;
+  entry.count           = count;
+  entry.type            = type;
+  entry.generation      = generation;
+  entry.type_generation = type_generation;
+  entry.verdict         = verdict;
+}
+
+}  // namespace typeart
@@ -0,0 +1,79 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_MPI_INTERCEPTOR_CALL_SITE_CACHE_H
+#define TYPEART_MPI_INTERCEPTOR_CALL_SITE_CACHE_H
+
+#include "TypeCheck.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mpi.h>
+
+namespace typeart {
+
+namespace call_site_cache {
+// Number of entries of the per-thread cache, must be a power of two.
+constexpr size_t cache_size = 256;
+
+static_assert(__builtin_popcountll(cache_size) == 1);
+}  // namespace call_site_cache
+
+// A successful check of a buffer, as logged for the call.
+struct CallSiteVerdict {
+  PointerInfo pointer_info;
+  // Owned by the MPITypeCache, valid as long as the entry is (see invalidate_types).
+  const MPIType* mpi_type;
+};
+
+// A per-thread, direct-mapped cache of successful buffer checks, keyed by the call site and the exact arguments.
+// Entries are valid as long as neither the generation of the runtime (allocations freed) nor the generation of
+// datatypes (MPI_Type_free) changed, such that a hit neither queries the runtime nor checks the types again.
+class CallSiteCache {
+  struct Entry {
+    const void* called_from = nullptr;
+    const void* ptr         = nullptr;
+    int count{0};
+    MPI_Datatype type{MPI_DATATYPE_NULL};
+    std::uint64_t generation{0};
+    std::uint64_t type_generation{0};
+    CallSiteVerdict verdict{};
+  };
+
+  std::array<Entry, call_site_cache::cache_size> entries{};
+
+  static inline size_t index_for(const void* called_from, const void* ptr) {
+    const auto value = reinterpret_cast<uintptr_t>(called_from) ^ (reinterpret_cast<uintptr_t>(ptr) >> 4U);
+    return (value ^ (value >> 9U)) & (call_site_cache::cache_size - 1);
+  }
+
+ public:
+  static CallSiteCache& get();
+
+  // Must be called whenever a datatype is freed (after it was removed from the MPITypeCache), invalidates all entries
+  // of all threads.
+  static void invalidate_types();
+
+  static std::uint64_t current_type_generation();
+
+  const CallSiteVerdict* find(const void* called_from, const void* ptr, int count, MPI_Datatype type) const;
+
+  // The generation must be the one of the PointerInfo lookup, see PointerInfo::get_with_generation, and the
+  // type generation must be read before the MPIType is retrieved from the MPITypeCache.
+  void insert(const void* called_from, const void* ptr, int count, MPI_Datatype type, std::uint64_t generation,
+              std::uint64_t type_generation, const CallSiteVerdict& verdict);
+};
+
+}  // namespace typeart
+
+#endif  // TYPEART_MPI_INTERCEPTOR_CALL_SITE_CACHE_H
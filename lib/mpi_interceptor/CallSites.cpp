@@ -0,0 +1,42 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "CallSites.h"
+
+namespace typeart {
+
+CallSiteRegistry& CallSiteRegistry::get() {
+  static CallSiteRegistry registry;
+  return registry;
+}
+
+CallSiteCounter& CallSiteRegistry::counter_for(const char* function_name, const void* called_from) {
+  // Call sites are few, hence each thread remembers the ones it has seen to avoid locking.
+  static thread_local std::unordered_map<const void*, CallSiteCounter*> known_sites;
+  if (const auto it = known_sites.find(called_from); it != known_sites.end()) {
+    return *it->second;
+  }
+
+  CallSiteCounter* site{nullptr};
+  {
+    std::unique_lock<std::shared_mutex> guard(mutex);
+    auto& entry = sites[called_from];
+    if (!entry) {
+      entry = std::make_unique<CallSiteCounter>(function_name, called_from);
+    }
+    site = entry.get();
+  }
+  known_sites.emplace(called_from, site);
+  return *site;
+}
+
+}  // namespace typeart
@@ -0,0 +1,81 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_MPI_INTERCEPTOR_CALL_SITES_H
+#define TYPEART_MPI_INTERCEPTOR_CALL_SITES_H
+
+#include "CheckTimes.h"
+#include "Config.h"
+#include "Stats.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace typeart {
+
+// Owns the counters of all call sites (return addresses of intercepted calls) seen so far. Counters are never
+// removed, references to them remain valid.
+class CallSiteRegistry {
+  std::shared_mutex mutex;
+  std::unordered_map<const void*, std::unique_ptr<CallSiteCounter>> sites;
+
+ public:
+  static CallSiteRegistry& get();
+
+  CallSiteCounter& counter_for(const char* function_name, const void* called_from);
+
+  template <class Fn>
+  void for_each(Fn&& fn) {
+    std::shared_lock<std::shared_mutex> guard(mutex);
+    for (const auto& [called_from, site] : sites) {
+      fn(static_cast<const CallSiteCounter&>(*site));
+    }
+  }
+};
+
+// Adds the time from its construction to its destruction to the check time of the function (see CheckTimes) and of
+// the call site. Only the overhead budget and the report need the times, otherwise the timer does nothing (see
+// Config::isWithCheckTimes).
+class CheckTimer {
+  const char* function_name;
+  CallSiteCounter* site;
+  std::chrono::steady_clock::time_point start{};
+
+ public:
+  CheckTimer(const char* function_name, CallSiteCounter* site)
+      : function_name(function_name), site(Config::get().isWithCheckTimes() ? site : nullptr) {
+    if (this->site != nullptr) {
+      start = std::chrono::steady_clock::now();
+    }
+  }
+
+  CheckTimer(const CheckTimer&) = delete;
+  CheckTimer& operator=(const CheckTimer&) = delete;
+
+  ~CheckTimer() {
+    if (site != nullptr) {
+      const auto elapsed = std::chrono::steady_clock::now() - start;
+      const auto check_ns =
+          static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+      CheckTimes::get().add(function_name, check_ns);
+      site->check_ns += check_ns;
+    }
+  }
+};
+
+}  // namespace typeart
+
+#endif  // TYPEART_MPI_INTERCEPTOR_CALL_SITES_H
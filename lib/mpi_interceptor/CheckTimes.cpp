@@ -0,0 +1,110 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "CheckTimes.h"
+
+#include <map>
+#include <string>
+
+namespace typeart {
+
+namespace {
+// Only the owning thread writes to the counters of a thread.
+inline void add_relaxed(std::atomic_uint64_t& counter, std::uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline size_t index_for(const char* function_name) {
+  const auto value = reinterpret_cast<uintptr_t>(function_name) >> 3U;
+  return (value ^ (value >> 9U)) & (check_times::table_size - 1);
+}
+}  // namespace
+
+CheckTimes& CheckTimes::get() {
+  static CheckTimes times;
+  return times;
+}
+
+CheckTimes::ThreadTimes& CheckTimes::local() {
+  static thread_local ThreadTimes* times = [this] {
+    std::lock_guard<std::mutex> guard(mutex);
+    return threads.emplace_back(std::make_unique<ThreadTimes>()).get();
+  }();
+  return *times;
+}
+
+void CheckTimes::add(const char* function_name, std::uint64_t check_ns) {
+  auto& times = local();
+  add_relaxed(times.check_ns, check_ns);
+
+  // Function names are string literals of the wrappers, hence compared by address (linear probing).
+  const auto index = index_for(function_name);
+  for (size_t i = 0; i < check_times::table_size; ++i) {
+    auto& entry      = times.entries[(index + i) & (check_times::table_size - 1)];
+    const auto* name = entry.function_name.load(std::memory_order_relaxed);
+    if (name == nullptr) {
+      entry.function_name.store(function_name, std::memory_order_release);
+    } else if (name != function_name) {
+      continue;
+    }
+    add_relaxed(entry.checks, 1);
+    add_relaxed(entry.check_ns, check_ns);
+    return;
+  }
+}
+
+void CheckTimes::add_budget_skipped() {
+  add_relaxed(local().budget_skipped, 1);
+}
+
+bool CheckTimes::is_over_budget(double fraction) {
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  const auto budget  = fraction * std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  return static_cast<double>(local().check_ns.load(std::memory_order_relaxed)) > budget;
+}
+
+std::vector<FunctionTime> CheckTimes::per_function() {
+  std::map<std::string, FunctionTime> functions;
+  std::lock_guard<std::mutex> guard(mutex);
+  for (const auto& times : threads) {
+    for (const auto& entry : times->entries) {
+      const auto* name = entry.function_name.load(std::memory_order_acquire);
+      if (name == nullptr) {
+        continue;
+      }
+      auto& function = functions.try_emplace(name, FunctionTime{name, 0, 0}).first->second;
+      function.checks += entry.checks.load(std::memory_order_relaxed);
+      function.check_ns += entry.check_ns.load(std::memory_order_relaxed);
+    }
+  }
+  std::vector<FunctionTime> result;
+  result.reserve(functions.size());
+  for (const auto& [name, function] : functions) {
+    result.push_back(function);
+  }
+  return result;
+}
+
+CheckTimeCounter CheckTimes::totals() {
+  CheckTimeCounter counter;
+  std::lock_guard<std::mutex> guard(mutex);
+  for (const auto& times : threads) {
+    for (const auto& entry : times->entries) {
+      counter.checks += entry.checks.load(std::memory_order_relaxed);
+    }
+    counter.check_ns += times->check_ns.load(std::memory_order_relaxed);
+    counter.budget_skipped += times->budget_skipped.load(std::memory_order_relaxed);
+  }
+  return counter;
+}
+
+}  // namespace typeart
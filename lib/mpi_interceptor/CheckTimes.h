@@ -0,0 +1,84 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_MPI_INTERCEPTOR_CHECK_TIMES_H
+#define TYPEART_MPI_INTERCEPTOR_CHECK_TIMES_H
+
+#include "Stats.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace typeart {
+
+namespace check_times {
+// Number of functions timed per thread, must be a power of two and exceed the number of intercepted functions.
+constexpr size_t table_size = 512;
+
+static_assert(__builtin_popcountll(table_size) == 1);
+}  // namespace check_times
+
+// The time spent checking the calls of one MPI function.
+struct FunctionTime {
+  const char* function_name;
+  std::uint64_t checks;
+  std::uint64_t check_ns;
+};
+
+// Accumulates the time spent checking per intercepted function. Each thread has its own table, which only the owning
+// thread writes to, hence the counters are updated with relaxed loads and stores instead of atomic read-modify-write
+// operations. The tables are kept when their thread exits.
+class CheckTimes {
+  struct Entry {
+    std::atomic<const char*> function_name{nullptr};
+    std::atomic_uint64_t checks{0};
+    std::atomic_uint64_t check_ns{0};
+  };
+
+  struct ThreadTimes {
+    std::array<Entry, check_times::table_size> entries{};
+    std::atomic_uint64_t check_ns{0};
+    std::atomic_uint64_t budget_skipped{0};
+  };
+
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadTimes>> threads;
+  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+
+  ThreadTimes& local();
+
+ public:
+  static CheckTimes& get();
+
+  void add(const char* function_name, std::uint64_t check_ns);
+
+  // A call which was not checked as the thread exceeded the overhead budget.
+  void add_budget_skipped();
+
+  // Whether the checks of the calling thread took longer than fraction of the time since the first check.
+  bool is_over_budget(double fraction);
+
+  // The times of all threads, summed up per function.
+  std::vector<FunctionTime> per_function();
+
+  CheckTimeCounter totals();
+};
+
+}  // namespace typeart
+
+#endif  // TYPEART_MPI_INTERCEPTOR_CHECK_TIMES_H
@@ -12,6 +12,7 @@
 
 #include "Config.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <utility>
@@ -23,8 +24,42 @@ bool strcmp_any_of(const char* lhs, String... rhs) {
   return lhs != nullptr && ((std::strcmp(lhs, rhs) == 0) || ...);
 }
 
+namespace {
+size_t size_from_env(const char* name, size_t default_value) {
+  const auto* value = std::getenv(name);
+  if (value == nullptr) {
+    return default_value;
+  }
+  char* end;
+  const auto result = std::strtoull(value, &end, 10);
+  return end != value && *end == '\0' ? result : default_value;
+}
+
+double double_from_env(const char* name, double default_value) {
+  const auto* value = std::getenv(name);
+  if (value == nullptr) {
+    return default_value;
+  }
+  char* end;
+  const auto result = std::strtod(value, &end);
+  return end != value && *end == '\0' ? result : default_value;
+}
+}  // namespace
+
+bool Config::SamplingPolicy::shouldCheck(size_t call, size_t passed) const {
+  if (call < first) {
+    return true;
+  }
+  // Bounds the interval to rate * 2^16.
+  constexpr size_t max_backoff_shift = 16;
+  const auto shift    = backoff > 0 ? std::min(passed / backoff, max_backoff_shift) : 0;
+  const auto interval = std::max(rate, size_t{1}) << shift;
+  return (call - first) % interval == 0;
+}
+
 Config::Config() {
-  with_backtraces = strcmp_any_of(std::getenv("TYPEART_STACKTRACE"), "1", "ON");
+  with_backtraces   = strcmp_any_of(std::getenv("TYPEART_STACKTRACE"), "1", "ON");
+  with_async_checks = strcmp_any_of(std::getenv("TYPEART_ASYNC_CHECKS"), "1", "ON");
 
   auto source_location_env = std::getenv("TYPEART_SOURCE_LOCATION");
 
@@ -35,6 +70,26 @@ Config::Config() {
   } else {
     source_location = SourceLocation::None;
   }
+
+  sampling_policy.rate    = size_from_env("TYPEART_SAMPLING_RATE", 1);
+  sampling_policy.first   = size_from_env("TYPEART_SAMPLING_FIRST", 0);
+  sampling_policy.backoff = size_from_env("TYPEART_SAMPLING_BACKOFF", 0);
+
+  // The budget is given in percent.
+  overhead_budget.fraction = double_from_env("TYPEART_OVERHEAD_BUDGET", 0) / 100;
+  overhead_budget.rate     = std::max(size_from_env("TYPEART_OVERHEAD_SAMPLING_RATE", 16), size_t{1});
+
+  auto report_env = std::getenv("TYPEART_REPORT");
+
+  if (strcmp_any_of(report_env, "json", "JSON")) {
+    report = Report::JSON;
+  } else if (strcmp_any_of(report_env, "csv", "CSV")) {
+    report = Report::CSV;
+  } else {
+    report = Report::None;
+  }
+
+  report_file = std::getenv("TYPEART_REPORT_FILE");
 }
 
 }  // namespace typeart
@@ -13,15 +13,49 @@
 #ifndef TYPEART_MPI_INTERCEPTOR_CONFIG_H
 #define TYPEART_MPI_INTERCEPTOR_CONFIG_H
 
+#include <cstddef>
+
 namespace typeart {
 
 class Config {
  public:
   enum class SourceLocation { None, Error, All };
+  enum class Report { None, JSON, CSV };
+
+  // Decides which calls of a call site are checked: the first `first` calls, then every `rate`-th call. Once
+  // `backoff` calls of the site passed the check, the interval is doubled for every further `backoff` passes.
+  struct SamplingPolicy {
+    size_t rate{1};
+    size_t first{0};
+    size_t backoff{0};
+
+    bool isEnabled() const {
+      return rate > 1 || backoff > 0;
+    }
+
+    // call is the (zero-based) index of the call at the site, passed the number of checks of the site that passed.
+    bool shouldCheck(size_t call, size_t passed) const;
+  };
+
+  // Once the checks of a thread took longer than `fraction` of the time since the first check, call sites which
+  // already passed a check are only checked every `rate`-th call, until the thread is within the budget again.
+  struct OverheadBudget {
+    double fraction{0};
+    size_t rate{16};
+
+    bool isEnabled() const {
+      return fraction > 0;
+    }
+  };
 
  private:
   bool with_backtraces;
+  bool with_async_checks;
   SourceLocation source_location;
+  SamplingPolicy sampling_policy;
+  OverheadBudget overhead_budget;
+  Report report;
+  const char* report_file;
 
   Config();
 
@@ -35,9 +69,41 @@ class Config {
     return with_backtraces;
   }
 
+  // Buffers of non-blocking calls are checked on a helper thread.
+  bool isWithAsyncChecks() const {
+    return with_async_checks;
+  }
+
   SourceLocation getSourceLocation() const {
     return source_location;
   }
+
+  const SamplingPolicy& getSamplingPolicy() const {
+    return sampling_policy;
+  }
+
+  const OverheadBudget& getOverheadBudget() const {
+    return overhead_budget;
+  }
+
+  // Format of the call site report of all ranks, written by rank 0 at MPI_Finalize.
+  Report getReport() const {
+    return report;
+  }
+
+  bool isWithReport() const {
+    return report != Report::None;
+  }
+
+  // Checks are only timed for the overhead budget and the report, see CheckTimer.
+  bool isWithCheckTimes() const {
+    return overhead_budget.isEnabled() || isWithReport();
+  }
+
+  // File the report is written to, nullptr if it is logged instead.
+  const char* getReportFile() const {
+    return report_file;
+  }
 };
 
 }  // namespace typeart
@@ -53,6 +53,11 @@ struct [[nodiscard]] VariantError {
     return std::get<T>(std::move(data));
   }
 
+  // Index of the alternative held.
+  [[nodiscard]] size_t index() const {
+    return data.index();
+  }
+
   template <class Visitor>
   auto visit(Visitor&& visitor) const -> decltype(auto) {
     return std::visit(std::forward<Visitor>(visitor), data);
@@ -137,10 +142,16 @@ struct StructSubtypeErrors {
   std::vector<StructSubtypeMismatch> subtype_errors;
 };
 
+// The type signature of a datatype does not consist of the predefined datatype of the target (e.g., a file view).
+struct SignatureMismatch {
+  MPI_Datatype expected;
+  MPI_Datatype actual;
+};
+
 struct [[nodiscard]] TypeError
     : public detail::VariantError<StructSubtypeErrors, InsufficientBufferSize, BuiltinTypeMismatch,
                                   BufferNotOfStructType, MemberCountMismatch, MemberOffsetMismatch, MemberTypeMismatch,
-                                  MemberElementCountMismatch> {};
+                                  MemberElementCountMismatch, SignatureMismatch> {};
 
 struct [[nodiscard]] Error : public detail::VariantError<InternalError, TypeError> {
   std::optional<Stacktrace> stacktrace =
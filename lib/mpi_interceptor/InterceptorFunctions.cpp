@@ -10,25 +10,99 @@
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
+#include "AsyncChecker.h"
+#include "CallSiteCache.h"
+#include "CallSites.h"
+#include "CheckTimes.h"
+#include "Config.h"
 #include "Logger.h"
+#include "PersistentRequests.h"
+#include "Report.h"
 #include "Stats.h"
+#include "TargetSignatures.h"
 #include "TypeCheck.h"
 
+#include <algorithm>
 #include <bits/types/struct_rusage.h>
+#include <climits>
 #include <fmt/printf.h>
+#include <fstream>
+#include <map>
 #include <mpi.h>
 #include <optional>
+#include <string>
 #include <sys/resource.h>
 #include <typeart/support/System.hpp>
 
 namespace typeart {
 
-void check_buffer(const char* name, const void* called_from, bool is_send, const void* ptr, int count,
+enum class CheckState { Failed, Passed, Pending };
+
+// Checks the arguments and resolves the buffer and the datatype of the check. Returns Pending if the types still
+// need to be compared by run_check. The CallSiteCache of the calling thread is only queried if memoized is set.
+CheckState prepare_check(BufferCheck& check, bool memoized = true);
+
+// Compares the types of a prepared check, returns true if the check passed. Successful checks are memoized in the
+// CallSiteCache of the calling thread if memoize is set.
+bool run_check(const BufferCheck& check, bool memoize);
+
+// Returns true if the buffer was successfully checked.
+bool check_buffer(const char* name, const void* called_from, bool is_send, const void* ptr, int count,
                   MPI_Datatype type);
 
+// Same as check_buffer, but the types are compared on the helper thread if asynchronous checks are enabled.
+void check_buffer_nonblocking(const char* name, const void* called_from, bool is_send, const void* ptr, int count,
+                              MPI_Datatype type, CallSiteCounter* site);
+
+// Decides whether the call is checked, see Config::SamplingPolicy and Config::OverheadBudget. site is set to the
+// counter of the call site if sampling, the overhead budget or the report is enabled, nullptr otherwise.
+bool sample_call(const char* name, const void* called_from, CallSiteCounter*& site);
+
+void record_passed(CallSiteCounter* site, bool passed);
+
+// Checks the buffer of a persistent request at init and records the check for the request.
+void check_buffer_persistent(const char* name, const void* called_from, bool is_send, const void* ptr, int count,
+                             MPI_Datatype type, MPI_Request request, CallSiteCounter* site);
+
+// Checks the buffer of a started persistent request again if its verdict is outdated.
+void start_request(MPI_Request request);
+
+// Number of entries of the count and displacement arrays of a vector collective on comm.
+int peer_count(MPI_Comm comm);
+
+// Whether the calling process is the root of a rooted collective, and whether it sends to (or receives from) the
+// root as a non-root process.
+bool is_root(MPI_Comm comm, int root);
+bool is_non_root(MPI_Comm comm, int root);
+
+// Checks a buffer addressed by per-peer counts and displacements (in elements of type) against the largest extent.
+bool check_buffer_v(const char* name, const void* called_from, bool is_send, const void* ptr, const int* counts,
+                    const int* displs, MPI_Datatype type, int peers);
+
+// Checks a buffer addressed by per-peer counts, displacements (in bytes) and datatypes, each non-empty segment
+// separately. The buffer is looked up only once.
+bool check_buffer_w(const char* name, const void* called_from, bool is_send, const void* ptr, const int* counts,
+                    const int* displs, const MPI_Datatype* types, int peers);
+
+// Checks the datatype of a data-access call against the etype of the file view, if a view was set for the file.
+void check_file_view(const char* name, const void* called_from, MPI_File fh, MPI_Datatype type);
+
+// Checks the target datatype of a one-sided call against the memory of the window, if the memory has a known type.
+// Windows are assumed to be symmetric, i.e., the memory of the target process has the type of the local memory.
+void check_window(const char* name, const void* called_from, MPI_Win win, MPI_Datatype type);
+
 static CallCounter call_counter;
 static MPICounter mpi_counter;
+static CallSiteCacheCounter call_site_cache_counter;
 static Logger logger;
+static MPITypeCache type_cache;
+static VerdictCache verdict_cache;
+static AsyncChecker async_checker;
+static PersistentRequests persistent_requests;
+static TargetSignatureCounter target_signature_counter;
+// The predefined datatype of the etype of each file view.
+static TargetSignatures<MPI_File, MPI_Datatype> file_views;
+static TargetSignatures<MPI_Win, PointerInfo> windows;
 
 }  // namespace typeart
 
@@ -36,19 +110,237 @@ extern "C" {
 
 void typeart_check_send(const char* name, const void* called_from, const void* sendbuf, int count, MPI_Datatype dtype) {
   ++typeart::call_counter.send;
-  typeart::check_buffer(name, called_from, true, sendbuf, count, dtype);
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  typeart::record_passed(site, typeart::check_buffer(name, called_from, true, sendbuf, count, dtype));
 }
 
 void typeart_check_recv(const char* name, const void* called_from, void* recvbuf, int count, MPI_Datatype dtype) {
   ++typeart::call_counter.recv;
-  typeart::check_buffer(name, called_from, false, recvbuf, count, dtype);
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  typeart::record_passed(site, typeart::check_buffer(name, called_from, false, recvbuf, count, dtype));
 }
 
 void typeart_check_send_and_recv(const char* name, const void* called_from, const void* sendbuf, int sendcount,
                                  MPI_Datatype sendtype, void* recvbuf, int recvcount, MPI_Datatype recvtype) {
   ++typeart::call_counter.send_recv;
-  typeart::check_buffer(name, called_from, true, sendbuf, sendcount, sendtype);
-  typeart::check_buffer(name, called_from, false, recvbuf, recvcount, recvtype);
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  const bool send_passed = typeart::check_buffer(name, called_from, true, sendbuf, sendcount, sendtype);
+  const bool recv_passed = typeart::check_buffer(name, called_from, false, recvbuf, recvcount, recvtype);
+  typeart::record_passed(site, send_passed && recv_passed);
+}
+
+void typeart_check_send_nonblocking(const char* name, const void* called_from, const void* sendbuf, int count,
+                                    MPI_Datatype dtype) {
+  ++typeart::call_counter.send;
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  typeart::check_buffer_nonblocking(name, called_from, true, sendbuf, count, dtype, site);
+}
+
+void typeart_check_recv_nonblocking(const char* name, const void* called_from, void* recvbuf, int count,
+                                    MPI_Datatype dtype) {
+  ++typeart::call_counter.recv;
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  typeart::check_buffer_nonblocking(name, called_from, false, recvbuf, count, dtype, site);
+}
+
+void typeart_check_send_init(const char* name, const void* called_from, const void* sendbuf, int count,
+                             MPI_Datatype dtype, MPI_Request request) {
+  ++typeart::call_counter.send;
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  typeart::check_buffer_persistent(name, called_from, true, sendbuf, count, dtype, request, site);
+}
+
+void typeart_check_recv_init(const char* name, const void* called_from, void* recvbuf, int count, MPI_Datatype dtype,
+                             MPI_Request request) {
+  ++typeart::call_counter.recv;
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  typeart::check_buffer_persistent(name, called_from, false, recvbuf, count, dtype, request, site);
+}
+
+void typeart_start(int count, MPI_Request* requests) {
+  for (int i = 0; i < count; ++i) {
+    typeart::start_request(requests[i]);
+  }
+}
+
+void typeart_request_free(MPI_Request request) {
+  typeart::persistent_requests.erase(request);
+}
+
+void typeart_check_alltoallv(const char* name, const void* called_from, const void* sendbuf, const int* sendcounts,
+                             const int* sdispls, MPI_Datatype sendtype, void* recvbuf, const int* recvcounts,
+                             const int* rdispls, MPI_Datatype recvtype, MPI_Comm comm) {
+  ++typeart::call_counter.send_recv;
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  const auto peers = typeart::peer_count(comm);
+  bool passed      = true;
+  if (sendbuf != MPI_IN_PLACE) {
+    passed = typeart::check_buffer_v(name, called_from, true, sendbuf, sendcounts, sdispls, sendtype, peers);
+  }
+  passed = typeart::check_buffer_v(name, called_from, false, recvbuf, recvcounts, rdispls, recvtype, peers) && passed;
+  typeart::record_passed(site, passed);
+}
+
+void typeart_check_alltoallw(const char* name, const void* called_from, const void* sendbuf, const int* sendcounts,
+                             const int* sdispls, const MPI_Datatype* sendtypes, void* recvbuf, const int* recvcounts,
+                             const int* rdispls, const MPI_Datatype* recvtypes, MPI_Comm comm) {
+  ++typeart::call_counter.send_recv;
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  const auto peers = typeart::peer_count(comm);
+  bool passed      = true;
+  if (sendbuf != MPI_IN_PLACE) {
+    passed = typeart::check_buffer_w(name, called_from, true, sendbuf, sendcounts, sdispls, sendtypes, peers);
+  }
+  passed = typeart::check_buffer_w(name, called_from, false, recvbuf, recvcounts, rdispls, recvtypes, peers) && passed;
+  typeart::record_passed(site, passed);
+}
+
+void typeart_check_allgatherv(const char* name, const void* called_from, const void* sendbuf, int sendcount,
+                              MPI_Datatype sendtype, void* recvbuf, const int* recvcounts, const int* displs,
+                              MPI_Datatype recvtype, MPI_Comm comm) {
+  ++typeart::call_counter.send_recv;
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  bool passed = true;
+  if (sendbuf != MPI_IN_PLACE) {
+    passed = typeart::check_buffer(name, called_from, true, sendbuf, sendcount, sendtype);
+  }
+  passed = typeart::check_buffer_v(name, called_from, false, recvbuf, recvcounts, displs, recvtype,
+                                   typeart::peer_count(comm)) &&
+           passed;
+  typeart::record_passed(site, passed);
+}
+
+void typeart_check_gatherv(const char* name, const void* called_from, const void* sendbuf, int sendcount,
+                           MPI_Datatype sendtype, void* recvbuf, const int* recvcounts, const int* displs,
+                           MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  ++typeart::call_counter.send_recv;
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  bool passed = true;
+  // The receive arguments are only significant at the root.
+  if (typeart::is_non_root(comm, root) && sendbuf != MPI_IN_PLACE) {
+    passed = typeart::check_buffer(name, called_from, true, sendbuf, sendcount, sendtype);
+  }
+  if (typeart::is_root(comm, root)) {
+    passed = typeart::check_buffer_v(name, called_from, false, recvbuf, recvcounts, displs, recvtype,
+                                     typeart::peer_count(comm)) &&
+             passed;
+  }
+  typeart::record_passed(site, passed);
+}
+
+void typeart_check_scatterv(const char* name, const void* called_from, const void* sendbuf, const int* sendcounts,
+                            const int* displs, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                            MPI_Datatype recvtype, int root, MPI_Comm comm) {
+  ++typeart::call_counter.send_recv;
+  typeart::CallSiteCounter* site{nullptr};
+  if (!typeart::sample_call(name, called_from, site)) {
+    return;
+  }
+  const typeart::CheckTimer timer{name, site};
+  bool passed = true;
+  // The send arguments are only significant at the root.
+  if (typeart::is_root(comm, root)) {
+    passed = typeart::check_buffer_v(name, called_from, true, sendbuf, sendcounts, displs, sendtype,
+                                     typeart::peer_count(comm));
+  }
+  if (typeart::is_non_root(comm, root) && recvbuf != MPI_IN_PLACE) {
+    passed = typeart::check_buffer(name, called_from, false, recvbuf, recvcount, recvtype) && passed;
+  }
+  typeart::record_passed(site, passed);
+}
+
+void typeart_file_set_view(const char* name, const void* called_from, MPI_File fh, MPI_Datatype etype,
+                           MPI_Datatype filetype) {
+  auto etype_result    = typeart::type_cache.get(etype);
+  auto filetype_result = typeart::type_cache.get(filetype);
+  if (etype_result.has_error() || filetype_result.has_error()) {
+    typeart::file_views.erase(fh);
+    return;
+  }
+  // The view is only recorded if its etype has a single predefined datatype other than MPI_BYTE.
+  const auto basic_etype = typeart::basic_type_of(*etype_result.value());
+  if (basic_etype == MPI_DATATYPE_NULL || basic_etype == MPI_BYTE) {
+    typeart::file_views.erase(fh);
+    return;
+  }
+  const auto& mpi_type = *filetype_result.value();
+  const auto result    = typeart::check_signature(mpi_type, basic_etype);
+  if (result.has_error()) {
+    ++typeart::mpi_counter.type_error;
+  }
+  typeart::logger.log_view(name, called_from, mpi_type, basic_etype, result);
+  typeart::file_views.insert(fh, basic_etype);
+}
+
+void typeart_file_close(MPI_File fh) {
+  typeart::file_views.erase(fh);
+}
+
+void typeart_check_file_view(const char* name, const void* called_from, MPI_File fh, MPI_Datatype dtype) {
+  typeart::check_file_view(name, called_from, fh, dtype);
+}
+
+void typeart_win_create(MPI_Win win, const void* base, MPI_Aint size) {
+  if (base == nullptr || size <= 0) {
+    return;
+  }
+  // Windows of memory without a type (e.g., allocated by MPI) are not checked.
+  auto pointer_info_result = typeart::PointerInfo::get(base);
+  if (pointer_info_result.has_value()) {
+    typeart::windows.insert(win, std::move(pointer_info_result).value());
+  }
+}
+
+void typeart_win_free(MPI_Win win) {
+  typeart::windows.erase(win);
+}
+
+void typeart_check_window(const char* name, const void* called_from, MPI_Win win, MPI_Datatype target_dtype) {
+  typeart::check_window(name, called_from, win, target_dtype);
 }
 
 void typeart_unsupported_mpi_call(const char* name, const void* /*called_from*/) {
@@ -58,63 +350,466 @@ void typeart_unsupported_mpi_call(const char* name, const void* /*called_from*/)
 
 void typeart_exit() {
   // Called at MPI_Finalize time
+  typeart::async_checker.stop();
+  const auto& config = typeart::Config::get();
   int rank = 0;
   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
   struct rusage end;
   getrusage(RUSAGE_SELF, &end);
   typeart::logger.log(typeart::call_counter, end.ru_maxrss);
+  if (config.isWithCheckTimes()) {
+    typeart::logger.log(typeart::CheckTimes::get().totals());
+  }
   typeart::logger.log(typeart::mpi_counter);
+  typeart::logger.log(typeart::type_cache.get_counter());
+  typeart::logger.log(typeart::verdict_cache.get_counter());
+  typeart::logger.log(typeart::call_site_cache_counter);
+  typeart::logger.log(typeart::persistent_requests.get_counter());
+  typeart::logger.log(typeart::target_signature_counter);
+  typeart::logger.log_error_summary();
+
+  if (config.isWithCheckTimes()) {
+    for (const auto& function : typeart::CheckTimes::get().per_function()) {
+      typeart::logger.log_timing(function.function_name, function.checks, function.check_ns);
+    }
+  }
+
+  if (config.getSamplingPolicy().isEnabled() || config.getOverheadBudget().isEnabled()) {
+    std::map<std::string, std::pair<size_t, size_t>> sampled_by_function;
+    typeart::CallSiteRegistry::get().for_each([&](const typeart::CallSiteCounter& site) {
+      auto& [sampled, skipped] = sampled_by_function[site.function_name];
+      sampled += site.sampled;
+      skipped += site.skipped;
+    });
+    for (const auto& [function_name, counts] : sampled_by_function) {
+      typeart::logger.log_sampling(function_name.c_str(), counts.first, counts.second);
+    }
+  }
+
+  if (config.isWithReport()) {
+    const auto report = typeart::call_site_report(config.getReport());
+    if (rank == 0) {
+      if (config.getReportFile() == nullptr) {
+        typeart::logger.log_report(report);
+      } else if (!(std::ofstream{config.getReportFile()} << report << '\n')) {
+        typeart::logger.log_report_not_written(config.getReportFile());
+      }
+    }
+  }
+}
+
+void typeart_type_free(MPI_Datatype type) {
+  // Pending checks may refer to the datatype (e.g., its name).
+  typeart::async_checker.flush();
+  typeart::type_cache.invalidate(type);
+  typeart::verdict_cache.invalidate(type);
+  typeart::file_views.invalidate(type);
+  typeart::windows.invalidate(type);
+  typeart::CallSiteCache::invalidate_types();
+  typeart::logger.retire_errors(type);
 }
 
 }  // extern "C"
 
 namespace typeart {
 
-void check_buffer(const char* name, const void* called_from, bool is_send, const void* ptr, int count,
-                  MPI_Datatype type) {
-  const bool count_is_zero     = count <= 0;
-  const bool buffer_is_nullptr = ptr == nullptr;
+bool sample_call(const char* name, const void* called_from, CallSiteCounter*& site) {
+  const auto& config = Config::get();
+  const auto& policy = config.getSamplingPolicy();
+  const auto& budget = config.getOverheadBudget();
+  if (!policy.isEnabled() && !budget.isEnabled() && !config.isWithReport()) {
+    return true;
+  }
+  site            = &CallSiteRegistry::get().counter_for(name, called_from);
+  const auto call = site->calls++;
+  if (!policy.isEnabled() && !budget.isEnabled()) {
+    return true;
+  }
+  const auto passed = site->passed.load(std::memory_order_relaxed);
+  bool checked      = !policy.isEnabled() || policy.shouldCheck(call, passed);
+  if (checked && budget.isEnabled() && passed > 0 && call % budget.rate != 0 &&
+      CheckTimes::get().is_over_budget(budget.fraction)) {
+    CheckTimes::get().add_budget_skipped();
+    checked = false;
+  }
+  if (checked) {
+    ++site->sampled;
+  } else {
+    ++site->skipped;
+  }
+  return checked;
+}
+
+void record_passed(CallSiteCounter* site, bool passed) {
+  if (site == nullptr) {
+    return;
+  }
+  if (passed) {
+    ++site->passed;
+  } else {
+    ++site->errors;
+  }
+}
+
+CheckState prepare_check(BufferCheck& check, bool memoized) {
+  const bool count_is_zero     = check.count <= 0;
+  const bool buffer_is_nullptr = check.ptr == nullptr;
 
   if (buffer_is_nullptr) {
     ++mpi_counter.null_buff;
-    logger.log_null_buffer(name, called_from, is_send);
-    return;
+    logger.log_null_buffer(check.name, check.called_from, check.is_send);
+    return CheckState::Failed;
   }
 
   if (count_is_zero) {
     ++mpi_counter.null_count;
-    logger.log_zero_count(name, called_from, is_send, ptr);
+    logger.log_zero_count(check.name, check.called_from, check.is_send, check.ptr);
+    return CheckState::Failed;
+  }
+
+  if (memoized) {
+    auto& call_site_cache = CallSiteCache::get();
+    if (const auto* verdict = call_site_cache.find(check.called_from, check.ptr, check.count, check.type);
+        verdict != nullptr) {
+      ++call_site_cache_counter.hit;
+      logger.log(check.name, check.called_from, check.is_send, verdict->pointer_info, *verdict->mpi_type, check.count,
+                 Result<void>{});
+      return CheckState::Passed;
+    }
+    ++call_site_cache_counter.miss;
+  }
+  // Must be read before the type lookup, see CallSiteCache::insert.
+  check.type_generation = CallSiteCache::current_type_generation();
+
+  auto pointer_info_result =
+      PointerInfo::get_with_generation(pointer{check.ptr}, check.generation, check.allocation_base);
+  if (pointer_info_result.has_error()) {
+    ++mpi_counter.error;
+    logger.log(check.name, check.called_from, check.is_send, check.ptr,
+               {InternalError{TypeARTError{error_message_for(pointer_info_result.error())}}});
+    return CheckState::Failed;
+  }
+  check.pointer_info = std::move(pointer_info_result).value();
+
+  auto mpi_type_result = type_cache.get(check.type);
+
+  if (mpi_type_result.has_error()) {
+    ++mpi_counter.error;
+    logger.log(check.name, check.called_from, check.is_send, check.ptr, *std::move(mpi_type_result).error());
+    return CheckState::Failed;
+  }
+  check.mpi_type = std::move(mpi_type_result).value();
+  return CheckState::Pending;
+}
+
+bool run_check(const BufferCheck& check, bool memoize) {
+  const auto& mpi_type = *check.mpi_type;
+  auto result          = check_buffer(check.pointer_info, mpi_type, check.count, &verdict_cache);
+
+  if (result.has_error()) {
+    if (result.error()->is<InternalError>()) {
+      ++mpi_counter.error;
+    } else {
+      ++mpi_counter.type_error;
+    }
+  } else if (memoize) {
+    CallSiteCache::get().insert(check.called_from, check.ptr, check.count, check.type, check.generation,
+                                check.type_generation, {check.pointer_info, &mpi_type});
+  }
+
+  logger.log(check.name, check.called_from, check.is_send, check.pointer_info, mpi_type, check.count, result);
+  return result.has_value();
+}
+
+bool check_buffer(const char* name, const void* called_from, bool is_send, const void* ptr, int count,
+                  MPI_Datatype type) {
+  BufferCheck check;
+  check.name        = name;
+  check.called_from = called_from;
+  check.is_send     = is_send;
+  check.ptr         = ptr;
+  check.count       = count;
+  check.type        = type;
+
+  switch (prepare_check(check)) {
+    case CheckState::Failed:
+      return false;
+    case CheckState::Passed:
+      return true;
+    case CheckState::Pending:
+      break;
+  }
+  return run_check(check, true);
+}
+
+// The helper thread calls into MPI (e.g., for datatype names), which requires MPI_THREAD_MULTIPLE.
+bool is_async_checker_started() {
+  static const bool started = [] {
+    if (!Config::get().isWithAsyncChecks()) {
+      return false;
+    }
+    int provided{MPI_THREAD_SINGLE};
+    MPI_Query_thread(&provided);
+    if (provided != MPI_THREAD_MULTIPLE) {
+      logger.log_async_unavailable();
+      return false;
+    }
+    // Not memoized, the CallSiteCache of the helper thread is never queried, see AsyncChecker.
+    async_checker.start([](const BufferCheck& check) { record_passed(check.site, run_check(check, false)); });
+    return true;
+  }();
+  return started;
+}
+
+void check_buffer_nonblocking(const char* name, const void* called_from, bool is_send, const void* ptr, int count,
+                              MPI_Datatype type, CallSiteCounter* site) {
+  if (!is_async_checker_started()) {
+    record_passed(site, check_buffer(name, called_from, is_send, ptr, count, type));
     return;
   }
 
+  BufferCheck check;
+  check.name        = name;
+  check.called_from = called_from;
+  check.is_send     = is_send;
+  check.ptr         = ptr;
+  check.count       = count;
+  check.type        = type;
+  check.site        = site;
+
+  switch (prepare_check(check)) {
+    case CheckState::Failed:
+      return;
+    case CheckState::Passed:
+      record_passed(site, true);
+      return;
+    case CheckState::Pending:
+      break;
+  }
+  // The queue is full, check inline instead of blocking the call.
+  if (!async_checker.submit(check)) {
+    ++mpi_counter.async_fallback;
+    record_passed(site, run_check(check, true));
+  }
+}
+
+void check_buffer_persistent(const char* name, const void* called_from, bool is_send, const void* ptr, int count,
+                             MPI_Datatype type, MPI_Request request, CallSiteCounter* site) {
+  BufferCheck check;
+  check.name        = name;
+  check.called_from = called_from;
+  check.is_send     = is_send;
+  check.ptr         = ptr;
+  check.count       = count;
+  check.type        = type;
+  check.site        = site;
+
+  // The generations of the lookups are kept with the request instead of the CallSiteCache.
+  const bool passed = prepare_check(check, false) == CheckState::Pending && run_check(check, false);
+  record_passed(site, passed);
+  if (request != MPI_REQUEST_NULL) {
+    persistent_requests.insert(request, check);
+  }
+}
+
+void start_request(MPI_Request request) {
+  auto check = persistent_requests.start(request);
+  if (!check) {
+    return;
+  }
+  if (prepare_check(*check, false) == CheckState::Pending) {
+    run_check(*check, false);
+  }
+  persistent_requests.update(request, *check);
+}
+
+int peer_count(MPI_Comm comm) {
+  int is_inter{0};
+  MPI_Comm_test_inter(comm, &is_inter);
+  int size{0};
+  if (is_inter) {
+    MPI_Comm_remote_size(comm, &size);
+  } else {
+    MPI_Comm_size(comm, &size);
+  }
+  return size;
+}
+
+bool is_root(MPI_Comm comm, int root) {
+  int is_inter{0};
+  MPI_Comm_test_inter(comm, &is_inter);
+  if (is_inter) {
+    return root == MPI_ROOT;
+  }
+  int rank{0};
+  MPI_Comm_rank(comm, &rank);
+  return rank == root;
+}
+
+bool is_non_root(MPI_Comm comm, int root) {
+  int is_inter{0};
+  MPI_Comm_test_inter(comm, &is_inter);
+  if (is_inter) {
+    // MPI_ROOT and MPI_PROC_NULL denote the processes of the root group.
+    return root >= 0;
+  }
+  // At the root, the send (or receive) buffer may also be given for the root itself, or be MPI_IN_PLACE.
+  return true;
+}
+
+bool check_buffer_v(const char* name, const void* called_from, bool is_send, const void* ptr, const int* counts,
+                    const int* displs, MPI_Datatype type, int peers) {
+  // The segments of all peers must be within the buffer, i.e., the buffer must hold max(displs[i] + counts[i])
+  // elements. Negative displacements are not checked.
+  long required_count{0};
+  for (int i = 0; i < peers; ++i) {
+    if (counts[i] > 0) {
+      required_count = std::max(required_count, static_cast<long>(displs[i]) + counts[i]);
+    }
+  }
+  if (required_count == 0) {
+    return true;
+  }
+  if (required_count > INT_MAX) {
+    ++mpi_counter.error;
+    logger.log(name, called_from, is_send, ptr,
+               {InternalError{InvalidArgument{fmt::format(
+                   "the segments span {} elements (the largest displacement plus count), more than INT_MAX",
+                   required_count)}}});
+    return false;
+  }
+  return check_buffer(name, called_from, is_send, ptr, static_cast<int>(required_count), type);
+}
+
+bool check_buffer_w(const char* name, const void* called_from, bool is_send, const void* ptr, const int* counts,
+                    const int* displs, const MPI_Datatype* types, int peers) {
+  if (std::none_of(counts, counts + peers, [](int count) { return count > 0; })) {
+    return true;
+  }
+  if (ptr == nullptr) {
+    ++mpi_counter.null_buff;
+    logger.log_null_buffer(name, called_from, is_send);
+    return false;
+  }
+
   auto pointer_info_result = PointerInfo::get(ptr);
   if (pointer_info_result.has_error()) {
     ++mpi_counter.error;
     logger.log(name, called_from, is_send, ptr,
                {InternalError{TypeARTError{error_message_for(pointer_info_result.error())}}});
-    return;
+    return false;
   }
   const auto pointer_info = std::move(pointer_info_result).value();
 
-  auto mpi_type = MPIType::create(type);
+  bool passed = true;
+  for (int i = 0; i < peers; ++i) {
+    if (counts[i] <= 0) {
+      continue;
+    }
+    const auto* segment = static_cast<const char*>(ptr) + displs[i];
 
-  if (mpi_type.has_error()) {
-    ++mpi_counter.error;
-    logger.log(name, called_from, is_send, ptr, *std::move(mpi_type).error());
+    auto segment_info = pointer_info.resolveAddr(pointer{segment});
+    if (segment_info.has_error()) {
+      ++mpi_counter.error;
+      logger.log(name, called_from, is_send, segment,
+                 {InternalError{TypeARTError{error_message_for(segment_info.error())}}});
+      passed = false;
+      continue;
+    }
+
+    auto mpi_type_result = type_cache.get(types[i]);
+    if (mpi_type_result.has_error()) {
+      ++mpi_counter.error;
+      logger.log(name, called_from, is_send, segment, *std::move(mpi_type_result).error());
+      passed = false;
+      continue;
+    }
+
+    BufferCheck check;
+    check.name         = name;
+    check.called_from  = called_from;
+    check.is_send      = is_send;
+    check.ptr          = segment;
+    check.count        = counts[i];
+    check.type         = types[i];
+    check.pointer_info = std::move(segment_info).value();
+    check.mpi_type     = std::move(mpi_type_result).value();
+    passed             = run_check(check, false) && passed;
+  }
+  return passed;
+}
+
+void check_file_view(const char* name, const void* called_from, MPI_File fh, MPI_Datatype type) {
+  bool matched{false};
+  const auto etype = file_views.find(fh, type, matched);
+  if (!etype) {
+    return;
+  }
+  // A memoized match only needs the decoded datatype for logging the successful check.
+  if (matched) {
+    ++target_signature_counter.view_hit;
+    if (!logger.logs_successes()) {
+      return;
+    }
+  }
+  // The datatype also describes the buffer, decoding errors are reported by the buffer check of the call.
+  auto mpi_type_result = type_cache.get(type);
+  if (mpi_type_result.has_error()) {
+    return;
+  }
+  const auto& mpi_type = *mpi_type_result.value();
+  if (matched) {
+    logger.log_view(name, called_from, mpi_type, *etype, Result<void>{});
     return;
   }
+  ++target_signature_counter.view_miss;
 
-  auto result = check_buffer(pointer_info, *mpi_type, count);
+  const auto result = check_signature(mpi_type, *etype);
+  if (result.has_error()) {
+    ++mpi_counter.type_error;
+  } else {
+    file_views.insert_match(fh, type);
+  }
+  logger.log_view(name, called_from, mpi_type, *etype, result);
+}
+
+void check_window(const char* name, const void* called_from, MPI_Win win, MPI_Datatype type) {
+  bool matched{false};
+  const auto window_info = windows.find(win, type, matched);
+  if (!window_info) {
+    return;
+  }
+  // A memoized match only needs the decoded datatype for logging the successful check.
+  if (matched) {
+    ++target_signature_counter.window_hit;
+    if (!logger.logs_successes()) {
+      return;
+    }
+  }
+  // Invalid target datatypes are reported by the call itself.
+  auto mpi_type_result = type_cache.get(type);
+  if (mpi_type_result.has_error()) {
+    return;
+  }
+  const auto& mpi_type = *mpi_type_result.value();
+  if (matched) {
+    logger.log_target(name, called_from, *window_info, mpi_type, Result<void>{});
+    return;
+  }
+  ++target_signature_counter.window_miss;
 
+  // Only the types are compared, the target displacement and count are not known to match the local memory.
+  const auto result = check_buffer(*window_info, mpi_type, 0, &verdict_cache);
   if (result.has_error()) {
     if (result.error()->is<InternalError>()) {
       ++mpi_counter.error;
     } else {
       ++mpi_counter.type_error;
     }
+  } else {
+    windows.insert_match(win, type);
   }
-
-  logger.log(name, called_from, is_send, pointer_info, *mpi_type, count, result);
+  logger.log_target(name, called_from, *window_info, mpi_type, result);
 }
 
 }  // namespace typeart
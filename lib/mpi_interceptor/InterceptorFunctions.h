@@ -26,10 +26,69 @@ void typeart_check_recv(const char* name, const void* called_from, void* recvbuf
 void typeart_check_send_and_recv(const char* name, const void* called_from, const void* sendbuf, int sendcount,
                                  MPI_Datatype sendtype, void* recvbuf, int recvcount, MPI_Datatype recvtype);
 
+void typeart_check_send_nonblocking(const char* name, const void* called_from, const void* sendbuf, int count,
+                                    MPI_Datatype dtype);
+
+void typeart_check_recv_nonblocking(const char* name, const void* called_from, void* recvbuf, int count,
+                                    MPI_Datatype dtype);
+
+// Persistent requests, the buffer is checked at init and only checked again by typeart_start if its verdict is
+// outdated. request is MPI_REQUEST_NULL if the init call failed.
+
+void typeart_check_send_init(const char* name, const void* called_from, const void* sendbuf, int count,
+                             MPI_Datatype dtype, MPI_Request request);
+
+void typeart_check_recv_init(const char* name, const void* called_from, void* recvbuf, int count, MPI_Datatype dtype,
+                             MPI_Request request);
+
+void typeart_start(int count, MPI_Request* requests);
+
+void typeart_request_free(MPI_Request request);
+
+// Vector collectives, the count and displacement arrays are checked against the extent of the buffers.
+
+void typeart_check_alltoallv(const char* name, const void* called_from, const void* sendbuf, const int* sendcounts,
+                             const int* sdispls, MPI_Datatype sendtype, void* recvbuf, const int* recvcounts,
+                             const int* rdispls, MPI_Datatype recvtype, MPI_Comm comm);
+
+void typeart_check_alltoallw(const char* name, const void* called_from, const void* sendbuf, const int* sendcounts,
+                             const int* sdispls, const MPI_Datatype* sendtypes, void* recvbuf, const int* recvcounts,
+                             const int* rdispls, const MPI_Datatype* recvtypes, MPI_Comm comm);
+
+void typeart_check_allgatherv(const char* name, const void* called_from, const void* sendbuf, int sendcount,
+                              MPI_Datatype sendtype, void* recvbuf, const int* recvcounts, const int* displs,
+                              MPI_Datatype recvtype, MPI_Comm comm);
+
+void typeart_check_gatherv(const char* name, const void* called_from, const void* sendbuf, int sendcount,
+                           MPI_Datatype sendtype, void* recvbuf, const int* recvcounts, const int* displs,
+                           MPI_Datatype recvtype, int root, MPI_Comm comm);
+
+void typeart_check_scatterv(const char* name, const void* called_from, const void* sendbuf, const int* sendcounts,
+                            const int* displs, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                            MPI_Datatype recvtype, int root, MPI_Comm comm);
+
+// File views and window memory, data-access calls compare their datatype against the signature recorded for the file
+// view (at MPI_File_set_view) or the window (at MPI_Win_create).
+
+void typeart_file_set_view(const char* name, const void* called_from, MPI_File fh, MPI_Datatype etype,
+                           MPI_Datatype filetype);
+
+void typeart_file_close(MPI_File fh);
+
+void typeart_check_file_view(const char* name, const void* called_from, MPI_File fh, MPI_Datatype dtype);
+
+void typeart_win_create(MPI_Win win, const void* base, MPI_Aint size);
+
+void typeart_win_free(MPI_Win win);
+
+void typeart_check_window(const char* name, const void* called_from, MPI_Win win, MPI_Datatype target_dtype);
+
 void typeart_unsupported_mpi_call(const char* name, const void* called_from);
 
 void typeart_exit();
 
+void typeart_type_free(MPI_Datatype type);
+
 #ifdef __cplusplus
 }
 #endif
@@ -99,6 +99,10 @@ struct TypeErrorVisitor {
                    });
     return fmt::format("{}. {}", err.primary_error->visit(*this), fmt::join(subtype_errors, ". "));
   }
+  std::string operator()(const SignatureMismatch& err) {
+    return fmt::format(R"(expected elements of MPI type "{}", but found elements of MPI type "{}")",
+                       name_for(err.expected), name_for(err.actual));
+  }
 };
 
 struct ErrorVisitor {
@@ -127,15 +131,45 @@ std::string format_source_location(spdlog::level::level_enum level, const void*
   return fmt::format("at {}: ", addr);
 }
 
-void Logger::log(const void* called_from, const std::string& prefix, const Error& error) {
+// The alternative of the error, for struct subtype errors the alternative of the primary error.
+size_t kind_of(const Error& error) {
+  constexpr size_t kinds_per_error = 64;
+  if (error.is<InternalError>()) {
+    return error.get<InternalError>().index();
+  }
+  const auto& type_error = error.get<TypeError>();
+  if (type_error.is<StructSubtypeErrors>()) {
+    return kinds_per_error * (error.index() + 1) + type_error.get<StructSubtypeErrors>().primary_error->index();
+  }
+  return kinds_per_error * error.index() + type_error.index();
+}
+
+size_t Logger::ErrorKeyHash::operator()(const ErrorKey& key) const {
+  auto hash = std::hash<const void*>{}(key.called_from);
+  hash ^= std::hash<size_t>{}(key.kind) + 0x9e3779b9 + (hash << 6U) + (hash >> 2U);
+  hash ^= std::hash<meta::meta_id_t::value_type>{}(key.type_id) + 0x9e3779b9 + (hash << 6U) + (hash >> 2U);
+  hash ^= std::hash<MPI_Datatype>{}(key.mpi_type) + 0x9e3779b9 + (hash << 6U) + (hash >> 2U);
+  return hash;
+}
+
+bool Logger::is_repeated(const ErrorKey& key) {
+  std::lock_guard<std::mutex> guard(error_mutex);
+  return ++errors[key].count > 1;
+}
+
+void Logger::log(const void* called_from, const ErrorKey& key, const std::string& prefix, const Error& error) {
   auto source_location = error.stacktrace.has_value() ? "" : format_source_location(spdlog::level::err, called_from);
-  LOG_ERROR("{}{}{}", source_location, prefix, error.visit(ErrorVisitor{}));
+  auto message         = fmt::format("{}{}{}", source_location, prefix, error.visit(ErrorVisitor{}));
+  LOG_ERROR("{}", message);
 
   if (error.stacktrace.has_value()) {
     for (const auto& entry : error.stacktrace.value()) {
       LOG_ERROR("\tin {}", entry);
     }
   }
+
+  std::lock_guard<std::mutex> guard(error_mutex);
+  errors[key].message = std::move(message);
 }
 
 void Logger::log(const char* name, const void* called_from, bool is_send, const PointerInfo& pointer_info,
@@ -146,9 +180,13 @@ void Logger::log(const char* name, const void* called_from, bool is_send, const
              pointer_info.getBaseAddr(), pointer_info.getCount(), pointer_info.getType().get_pretty_name(), count,
              count == 1 ? "element" : "elements", name_for(type.mpi_type));
   } else {
-    auto error                 = result.error();
+    auto error     = result.error();
+    const auto key = ErrorKey{called_from, kind_of(*error), pointer_info.getType().get_id().value(), type.mpi_type};
+    if (is_repeated(key)) {
+      return;
+    }
     auto internal_error_prefix = error->is<TypeError>() ? "type error " : "internal error ";
-    log(called_from,
+    log(called_from, key,
         fmt::format("{}: {}while checking {}-buffer {} of type [{} x {}] against {} {} of MPI type \"{}\": ", name,
                     internal_error_prefix, is_send ? "send" : "recv", pointer_info.getBaseAddr(),
                     pointer_info.getCount(), pointer_info.getType().get_pretty_name(), count,
@@ -157,24 +195,134 @@ void Logger::log(const char* name, const void* called_from, bool is_send, const
   }
 }
 
+bool Logger::logs_successes() const {
+#if TYPEART_LOG_LEVEL >= 3
+  return typeart::logger()->should_log(spdlog::level::info);
+#else
+  return false;
+#endif
+}
+
+void Logger::log_view(const char* name, const void* called_from, const MPIType& type, MPI_Datatype etype,
+                      const Result<void>& result) {
+  if (result.has_value()) {
+    LOG_INFO("{}{}: successfully checked MPI type \"{}\" against the file view of \"{}\" elements",
+             format_source_location(spdlog::level::info, called_from), name, name_for(type.mpi_type), name_for(etype));
+    return;
+  }
+  auto error     = result.error();
+  const auto key = ErrorKey{called_from, kind_of(*error), 0, type.mpi_type};
+  if (is_repeated(key)) {
+    return;
+  }
+  log(called_from, key,
+      fmt::format("{}: type error while checking MPI type \"{}\" against the file view of \"{}\" elements: ", name,
+                  name_for(type.mpi_type), name_for(etype)),
+      *error);
+}
+
+void Logger::log_target(const char* name, const void* called_from, const PointerInfo& window_info,
+                        const MPIType& type, const Result<void>& result) {
+  if (result.has_value()) {
+    LOG_INFO("{}{}: successfully checked target window {} of type [{} x {}] against MPI type \"{}\"",
+             format_source_location(spdlog::level::info, called_from), name, window_info.getBaseAddr(),
+             window_info.getCount(), window_info.getType().get_pretty_name(), name_for(type.mpi_type));
+    return;
+  }
+  auto error     = result.error();
+  const auto key = ErrorKey{called_from, kind_of(*error), window_info.getType().get_id().value(), type.mpi_type};
+  if (is_repeated(key)) {
+    return;
+  }
+  auto internal_error_prefix = error->is<TypeError>() ? "type error " : "internal error ";
+  log(called_from, key,
+      fmt::format("{}: {}while checking target window {} of type [{} x {}] against MPI type \"{}\": ", name,
+                  internal_error_prefix, window_info.getBaseAddr(), window_info.getCount(),
+                  window_info.getType().get_pretty_name(), name_for(type.mpi_type)),
+      *error);
+}
+
 void Logger::log(const char* name, const void* called_from, bool is_send, const void* ptr, const Error& error) {
+  const auto key = ErrorKey{called_from, kind_of(error), 0, MPI_DATATYPE_NULL};
+  if (is_repeated(key)) {
+    return;
+  }
   auto error_prefix = error.is<TypeError>() ? "error " : "internal error ";
-  log(called_from,
+  log(called_from, key,
       fmt::format("{}while checking the {}-buffer {} in a call to {}: ", error_prefix, is_send ? "send" : "recv", ptr,
                   name),
       error);
 }
 
+void Logger::log_error_summary() {
+  std::lock_guard<std::mutex> guard(error_mutex);
+  const auto unique = retired_errors.size() + errors.size();
+  size_t total      = 0;
+
+  const auto log_repeated = [&total](const ErrorRecord& record) {
+    total += record.count;
+    if (record.count > 1) {
+      LOG_INFO("Repeated error ({} occurrences): {}", record.count, record.message);
+    }
+  };
+  std::for_each(retired_errors.begin(), retired_errors.end(), log_repeated);
+  for (const auto& [key, record] : errors) {
+    log_repeated(record);
+  }
+  LOG_INFO("ECounter {{ Unique: {} Total: {} }}", unique, total);
+}
+
+void Logger::retire_errors(MPI_Datatype type) {
+  std::lock_guard<std::mutex> guard(error_mutex);
+  for (auto it = errors.begin(); it != errors.end();) {
+    if (it->first.mpi_type == type) {
+      retired_errors.push_back(std::move(it->second));
+      it = errors.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 void Logger::log(const CallCounter& call_counter, long ru_maxrss) {
   LOG_INFO("CCounter {{ Send: {} Recv: {} Send_Recv: {} Unsupported: {} MAX RSS[KBytes]: {} }}", call_counter.send,
            call_counter.recv, call_counter.send_recv, call_counter.unsupported, ru_maxrss);
 }
 
+void Logger::log(const CheckTimeCounter& check_time_counter) {
+  LOG_INFO("OCounter {{ Checks: {} Check_Time[us]: {} Budget_Skipped: {} }}", check_time_counter.checks,
+           check_time_counter.check_ns / 1000, check_time_counter.budget_skipped);
+}
+
 void Logger::log(const MPICounter& mpi_counter) {
   LOG_INFO("MCounter {{ Error: {} Null_Buf: {} Null_Count: {} Type_Error: {} }}", mpi_counter.error,
            mpi_counter.null_buff, mpi_counter.null_count, mpi_counter.type_error);
 }
 
+void Logger::log(const TypeCacheCounter& type_cache_counter) {
+  LOG_INFO("TCounter {{ Hit: {} Miss: {} Invalidated: {} }}", type_cache_counter.hit, type_cache_counter.miss,
+           type_cache_counter.invalidated);
+}
+
+void Logger::log(const VerdictCacheCounter& verdict_cache_counter) {
+  LOG_INFO("VCounter {{ Hit: {} Miss: {} }}", verdict_cache_counter.hit, verdict_cache_counter.miss);
+}
+
+void Logger::log(const CallSiteCacheCounter& call_site_cache_counter) {
+  LOG_INFO("SCounter {{ Hit: {} Miss: {} }}", call_site_cache_counter.hit, call_site_cache_counter.miss);
+}
+
+void Logger::log(const PersistentRequestCounter& persistent_request_counter) {
+  LOG_INFO("PCounter {{ Start: {} Revalidated: {} }}", persistent_request_counter.start,
+           persistent_request_counter.revalidated);
+}
+
+void Logger::log(const TargetSignatureCounter& target_signature_counter) {
+  LOG_INFO("FCounter {{ View_Hit: {} View_Miss: {} Window_Hit: {} Window_Miss: {} }}",
+           target_signature_counter.view_hit, target_signature_counter.view_miss, target_signature_counter.window_hit,
+           target_signature_counter.window_miss);
+}
+
 void Logger::log_zero_count(const char* function_name, const void* called_from, bool is_send, const void* ptr) {
   LOG_DEBUG("{}{}: attempted to {} 0 elements of buffer {}", format_source_location(spdlog::level::debug, called_from),
             function_name, is_send ? "send" : "receive", ptr);
@@ -189,4 +337,24 @@ void Logger::log_unsupported(const char* name) {
   LOG_ERROR("The MPI function {} is currently not checked by TypeArt", name);
 }
 
+void Logger::log_sampling(const char* function_name, size_t sampled, size_t skipped) {
+  LOG_INFO("Sampling {{ Function: {} Sampled: {} Skipped: {} }}", function_name, sampled, skipped);
+}
+
+void Logger::log_timing(const char* function_name, std::uint64_t checks, std::uint64_t check_ns) {
+  LOG_INFO("Timing {{ Function: {} Checks: {} Time[us]: {} }}", function_name, checks, check_ns / 1000);
+}
+
+void Logger::log_async_unavailable() {
+  LOG_WARNING("Asynchronous checks require MPI_THREAD_MULTIPLE, checking non-blocking calls inline");
+}
+
+void Logger::log_report(const std::string& report) {
+  LOG_INFO("Report {}", report);
+}
+
+void Logger::log_report_not_written(const char* file) {
+  LOG_ERROR("Could not write the report to {}", file);
+}
+
 }  // namespace typeart
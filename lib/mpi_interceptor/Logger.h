@@ -16,7 +16,12 @@
 #include "TypeCheck.h"
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace spdlog {
 class logger;
@@ -25,21 +30,75 @@ class logger;
 namespace typeart {
 
 class Logger {
+  // Errors are deduplicated by call site, kind of the error and type pair (the buffer's type and the MPI datatype).
+  struct ErrorKey {
+    const void* called_from;
+    size_t kind;
+    meta::meta_id_t::value_type type_id;
+    MPI_Datatype mpi_type;
+
+    bool operator==(const ErrorKey& other) const {
+      return called_from == other.called_from && kind == other.kind && type_id == other.type_id &&
+             mpi_type == other.mpi_type;
+    }
+  };
+
+  struct ErrorKeyHash {
+    size_t operator()(const ErrorKey& key) const;
+  };
+
+  struct ErrorRecord {
+    // The message of the first occurrence, set once it was logged.
+    std::string message;
+    size_t count{0};
+  };
+
+  std::mutex error_mutex;
+  std::unordered_map<ErrorKey, ErrorRecord, ErrorKeyHash> errors;
+  // Errors of freed datatypes, whose handles may be reused.
+  std::vector<ErrorRecord> retired_errors;
+
  public:
   Logger();
   ~Logger();
 
   void log(const char* name, const void* called_from, bool is_send, const PointerInfo& pointer_info,
            const MPIType& type, int count, const Result<void>&);
+  // Checks of a datatype against the view of a file (given by the predefined datatype of its etype), and of the target
+  // datatype of a one-sided call against the memory of the window.
+  void log_view(const char* name, const void* called_from, const MPIType& type, MPI_Datatype etype,
+                const Result<void>&);
+  void log_target(const char* name, const void* called_from, const PointerInfo& window_info, const MPIType& type,
+                  const Result<void>&);
+  // Whether successful checks are logged, i.e., info-level logging is compiled in and enabled.
+  bool logs_successes() const;
   void log(const char* function_name, const void* called_from, bool is_send, const void* ptr, const Error&);
   void log(const CallCounter& call_counter, long ru_maxrss);
   void log(const MPICounter& mpi_counter);
+  void log(const TypeCacheCounter& type_cache_counter);
+  void log(const VerdictCacheCounter& verdict_cache_counter);
+  void log(const CallSiteCacheCounter& call_site_cache_counter);
+  void log(const PersistentRequestCounter& persistent_request_counter);
+  void log(const CheckTimeCounter& check_time_counter);
+  void log(const TargetSignatureCounter& target_signature_counter);
   void log_zero_count(const char* function_name, const void* called_from, bool is_send, const void* ptr);
   void log_null_buffer(const char* function_name, const void* called_from, bool is_send);
   void log_unsupported(const char* name);
+  void log_sampling(const char* function_name, size_t sampled, size_t skipped);
+  void log_timing(const char* function_name, std::uint64_t checks, std::uint64_t check_ns);
+  void log_async_unavailable();
+  void log_report(const std::string& report);
+  void log_report_not_written(const char* file);
+  // Logs the number of unique errors and all errors which occurred more than once.
+  void log_error_summary();
+  // Must be called whenever a datatype is freed, later errors with the same handle are not deduplicated against
+  // earlier ones.
+  void retire_errors(MPI_Datatype type);
 
  private:
-  void log(const void* called_from, const std::string& info, const Error&);
+  // Counts the occurrence of the error, returns true if it occurred before (and must not be logged again).
+  bool is_repeated(const ErrorKey& key);
+  void log(const void* called_from, const ErrorKey& key, const std::string& info, const Error&);
 };
 
 }  // namespace typeart
@@ -0,0 +1,60 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "PersistentRequests.h"
+
+#include "CallSiteCache.h"
+
+namespace typeart {
+
+bool PersistentRequests::is_current(const BufferCheck& check) {
+  // Null buffers and counts are reported at init and do not depend on the runtime.
+  if (check.ptr == nullptr || check.count <= 0) {
+    return true;
+  }
+  // Only frees of the buffer's own allocation outdate the verdict, not frees of any other allocation.
+  return PointerInfo::is_unchanged_since(check.allocation_base, check.generation) &&
+         check.type_generation == CallSiteCache::current_type_generation();
+}
+
+void PersistentRequests::insert(MPI_Request request, const BufferCheck& check) {
+  std::lock_guard<std::mutex> guard(mutex);
+  requests.insert_or_assign(request, check);
+}
+
+std::optional<BufferCheck> PersistentRequests::start(MPI_Request request) {
+  std::lock_guard<std::mutex> guard(mutex);
+  const auto it = requests.find(request);
+  if (it == requests.end()) {
+    return {};
+  }
+  ++counter.start;
+  if (is_current(it->second)) {
+    return {};
+  }
+  ++counter.revalidated;
+  return it->second;
+}
+
+void PersistentRequests::update(MPI_Request request, const BufferCheck& check) {
+  std::lock_guard<std::mutex> guard(mutex);
+  if (const auto it = requests.find(request); it != requests.end()) {
+    it->second = check;
+  }
+}
+
+void PersistentRequests::erase(MPI_Request request) {
+  std::lock_guard<std::mutex> guard(mutex);
+  requests.erase(request);
+}
+
+}  // namespace typeart
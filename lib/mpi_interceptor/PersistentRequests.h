@@ -0,0 +1,56 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_MPI_INTERCEPTOR_PERSISTENT_REQUESTS_H
+#define TYPEART_MPI_INTERCEPTOR_PERSISTENT_REQUESTS_H
+
+#include "AsyncChecker.h"
+#include "Stats.h"
+
+#include <mpi.h>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+namespace typeart {
+
+// The checks of persistent requests (e.g., MPI_Send_init), keyed by the request handle. The buffer is checked once at
+// init, and MPI_Start only repeats the check if its verdict is outdated, i.e., if the allocation of the buffer (see
+// PointerInfo::is_unchanged_since) or any datatype was freed since. Buffers without a generation (see
+// PointerInfo::get_with_generation) are checked at every start.
+class PersistentRequests {
+  std::mutex mutex;
+  std::unordered_map<MPI_Request, BufferCheck> requests;
+  PersistentRequestCounter counter;
+
+  static bool is_current(const BufferCheck& check);
+
+ public:
+  // Records the (prepared and run) check of a request which was just initialized.
+  void insert(MPI_Request request, const BufferCheck& check);
+
+  // Returns the check of a started request if it has to be repeated, i.e., if its verdict is outdated.
+  std::optional<BufferCheck> start(MPI_Request request);
+
+  // Stores a check repeated for start, with the generations of its lookups.
+  void update(MPI_Request request, const BufferCheck& check);
+
+  void erase(MPI_Request request);
+
+  [[nodiscard]] const PersistentRequestCounter& get_counter() const {
+    return counter;
+  }
+};
+
+}  // namespace typeart
+
+#endif  // TYPEART_MPI_INTERCEPTOR_PERSISTENT_REQUESTS_H
@@ -0,0 +1,176 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "Report.h"
+
+#include "CallSites.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fmt/core.h>
+#include <map>
+#include <mpi.h>
+#include <string_view>
+#include <typeart/support/System.hpp>
+#include <vector>
+
+namespace typeart {
+
+namespace {
+
+constexpr size_t counter_count = 3;
+
+constexpr std::array<const char*, counter_count> counter_names = {"calls", "errors", "check_time_us"};
+
+using Counters = std::array<std::uint64_t, counter_count>;
+
+struct Aggregate {
+  int ranks{0};
+  Counters min{};
+  Counters max{};
+  Counters sum{};
+
+  void add(const Counters& counters) {
+    for (size_t i = 0; i < counter_count; ++i) {
+      min[i] = ranks == 0 ? counters[i] : std::min(min[i], counters[i]);
+      max[i] = std::max(max[i], counters[i]);
+      sum[i] += counters[i];
+    }
+    ++ranks;
+  }
+};
+
+// Function name and location of a call site, separated by a tab. The location is the binary and the offset of the
+// call site within it, as the address itself differs between ranks.
+std::string key_for(const CallSiteCounter& site) {
+  const auto binary = BinaryLocation::create(site.called_from);
+  if (!binary) {
+    return fmt::format("{}\t{}", site.function_name, site.called_from);
+  }
+  const auto offset = static_cast<const char*>(site.called_from) - static_cast<const char*>(binary->file_addr);
+  return fmt::format("{}\t{}+{:#x}", site.function_name, binary->file, offset);
+}
+
+std::string escape_json(std::string_view value) {
+  std::string result;
+  result.reserve(value.size());
+  for (const auto c : value) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+    }
+    result += c;
+  }
+  return result;
+}
+
+std::string format_report(const std::map<std::string, Aggregate>& sites, int size, Config::Report format) {
+  const auto mean = [size](std::uint64_t sum) { return static_cast<double>(sum) / size; };
+  // Ranks which never called the site count as 0.
+  const auto min = [size](const Aggregate& aggregate, size_t i) {
+    return aggregate.ranks < size ? std::uint64_t{0} : aggregate.min[i];
+  };
+
+  std::string report;
+  if (format == Config::Report::CSV) {
+    report = "function,location,ranks";
+    for (const auto* name : counter_names) {
+      report += fmt::format(",{0}_min,{0}_max,{0}_mean", name);
+    }
+    for (const auto& [key, aggregate] : sites) {
+      const auto delimiter = key.find('\t');
+      report += fmt::format("\n{},\"{}\",{}", key.substr(0, delimiter), key.substr(delimiter + 1), aggregate.ranks);
+      for (size_t i = 0; i < counter_count; ++i) {
+        report += fmt::format(",{},{},{:.2f}", min(aggregate, i), aggregate.max[i], mean(aggregate.sum[i]));
+      }
+    }
+    return report;
+  }
+
+  report = fmt::format(R"({{"ranks":{},"call_sites":[)", size);
+  bool first_site = true;
+  for (const auto& [key, aggregate] : sites) {
+    const auto delimiter = key.find('\t');
+    report += fmt::format(R"({}{{"function":"{}","location":"{}","ranks":{})", first_site ? "" : ",",
+                          key.substr(0, delimiter), escape_json(key.substr(delimiter + 1)), aggregate.ranks);
+    for (size_t i = 0; i < counter_count; ++i) {
+      report += fmt::format(R"(,"{}":{{"min":{},"max":{},"mean":{:.2f}}})", counter_names[i], min(aggregate, i),
+                            aggregate.max[i], mean(aggregate.sum[i]));
+    }
+    report += "}";
+    first_site = false;
+  }
+  report += "]}";
+  return report;
+}
+
+}  // namespace
+
+std::string call_site_report(Config::Report format) {
+  // The local call sites are serialized into their keys (newline separated) and their counters.
+  std::string keys;
+  std::vector<std::uint64_t> counters;
+  CallSiteRegistry::get().for_each([&](const CallSiteCounter& site) {
+    keys += key_for(site);
+    keys += '\n';
+    counters.insert(counters.end(), {site.calls.load(), site.errors.load(), site.check_ns.load() / 1000});
+  });
+
+  int rank{0};
+  int size{1};
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  // The PMPI functions are called directly, the intercepted ones would check the buffers.
+  std::array<int, 2> local_sizes = {static_cast<int>(keys.size()), static_cast<int>(counters.size())};
+  std::vector<int> all_sizes(rank == 0 ? 2 * size : 0);
+  PMPI_Gather(local_sizes.data(), 2, MPI_INT, all_sizes.data(), 2, MPI_INT, 0, MPI_COMM_WORLD);
+
+  std::vector<int> key_sizes;
+  std::vector<int> key_displs;
+  std::vector<int> counter_sizes;
+  std::vector<int> counter_displs;
+  if (rank == 0) {
+    for (int i = 0; i < size; ++i) {
+      key_displs.push_back(key_sizes.empty() ? 0 : key_displs.back() + key_sizes.back());
+      key_sizes.push_back(all_sizes[2 * i]);
+      counter_displs.push_back(counter_sizes.empty() ? 0 : counter_displs.back() + counter_sizes.back());
+      counter_sizes.push_back(all_sizes[2 * i + 1]);
+    }
+  }
+
+  std::string all_keys(rank == 0 ? key_displs.back() + key_sizes.back() : 0, '\0');
+  std::vector<std::uint64_t> all_counters(rank == 0 ? counter_displs.back() + counter_sizes.back() : 0);
+  PMPI_Gatherv(keys.data(), local_sizes[0], MPI_CHAR, all_keys.data(), key_sizes.data(), key_displs.data(), MPI_CHAR,
+               0, MPI_COMM_WORLD);
+  PMPI_Gatherv(counters.data(), local_sizes[1], MPI_UINT64_T, all_counters.data(), counter_sizes.data(),
+               counter_displs.data(), MPI_UINT64_T, 0, MPI_COMM_WORLD);
+
+  if (rank != 0) {
+    return {};
+  }
+
+  // The call sites of a rank are in the same order as their counters.
+  std::map<std::string, Aggregate> sites;
+  size_t key_begin = 0;
+  for (size_t site = 0; site * counter_count < all_counters.size(); ++site) {
+    const auto key_end = all_keys.find('\n', key_begin);
+    Counters site_counters;
+    std::copy_n(all_counters.begin() + site * counter_count, counter_count, site_counters.begin());
+    sites[all_keys.substr(key_begin, key_end - key_begin)].add(site_counters);
+    key_begin = key_end + 1;
+  }
+
+  return format_report(sites, size, format);
+}
+
+}  // namespace typeart
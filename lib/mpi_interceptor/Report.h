@@ -0,0 +1,30 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_MPI_INTERCEPTOR_REPORT_H
+#define TYPEART_MPI_INTERCEPTOR_REPORT_H
+
+#include "Config.h"
+
+#include <string>
+
+namespace typeart {
+
+// Gathers the counters of all call sites (see CallSiteRegistry) of all ranks of MPI_COMM_WORLD at rank 0. Call sites
+// are identified by the function name and their offset within the binary, such that they match across ranks. Returns
+// the report with the minimum, maximum and mean of each counter across all ranks (ranks which never called the site
+// count as 0) on rank 0, and an empty string on all other ranks. Collective, must be called before MPI_Finalize.
+std::string call_site_report(Config::Report format);
+
+}  // namespace typeart
+
+#endif  // TYPEART_MPI_INTERCEPTOR_REPORT_H
@@ -14,6 +14,7 @@
 #define TYPEART_MPI_INTERCEPTOR_STATS_H
 
 #include <atomic>
+#include <cstdint>
 
 namespace typeart {
 
@@ -29,6 +30,62 @@ struct MPICounter {
   std::atomic_size_t null_buff  = {0};
   std::atomic_size_t type_error = {0};
   std::atomic_size_t error      = {0};
+
+  // Checks of non-blocking calls which were run inline as the queue of the helper thread was full.
+  std::atomic_size_t async_fallback = {0};
+};
+
+struct TypeCacheCounter {
+  std::atomic_size_t hit         = {0};
+  std::atomic_size_t miss        = {0};
+  std::atomic_size_t invalidated = {0};
+};
+
+struct CallSiteCounter {
+  const char* function_name;
+  const void* called_from;
+  std::atomic_size_t calls   = {0};
+  std::atomic_size_t passed  = {0};
+  std::atomic_size_t sampled = {0};
+  std::atomic_size_t skipped = {0};
+  // Checked calls which did not pass (including null buffers and counts).
+  std::atomic_size_t errors = {0};
+  // Time spent in the checks of the calling threads if a report was requested, see CheckTimer.
+  std::atomic_uint64_t check_ns = {0};
+
+  CallSiteCounter(const char* function_name, const void* called_from)
+      : function_name(function_name), called_from(called_from) {
+  }
+};
+
+struct CallSiteCacheCounter {
+  std::atomic_size_t hit  = {0};
+  std::atomic_size_t miss = {0};
+};
+
+struct VerdictCacheCounter {
+  std::atomic_size_t hit  = {0};
+  std::atomic_size_t miss = {0};
+};
+
+// A snapshot of CheckTimes.
+struct CheckTimeCounter {
+  std::uint64_t checks{0};
+  std::uint64_t check_ns{0};
+  std::uint64_t budget_skipped{0};
+};
+
+struct PersistentRequestCounter {
+  std::atomic_size_t start       = {0};
+  std::atomic_size_t revalidated = {0};
+};
+
+// Comparisons of datatypes against the signatures of file views and window memory, see TargetSignatures.
+struct TargetSignatureCounter {
+  std::atomic_size_t view_hit    = {0};
+  std::atomic_size_t view_miss   = {0};
+  std::atomic_size_t window_hit  = {0};
+  std::atomic_size_t window_miss = {0};
 };
 
 }  // namespace typeart
@@ -0,0 +1,81 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_MPI_INTERCEPTOR_TARGET_SIGNATURES_H
+#define TYPEART_MPI_INTERCEPTOR_TARGET_SIGNATURES_H
+
+#include <mpi.h>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace typeart {
+
+// The type signatures of the targets of data-access calls, keyed by their handle (e.g., the etype of the view of an
+// MPI_File, or the memory of an MPI_Win). The datatypes which matched the target are memoized per handle, so that
+// later accesses with the same datatype only take one lookup. Mismatches are not memoized, their diagnostics refer to
+// the checked call. Like VerdictCache, datatypes must be invalidated on MPI_Type_free.
+template <typename Handle, typename Target>
+class TargetSignatures {
+  struct Entry {
+    Target target;
+    std::unordered_set<MPI_Datatype> matching;
+  };
+
+  std::shared_mutex mutex;
+  std::unordered_map<Handle, Entry> entries;
+
+ public:
+  // Records the target of handle, replacing a previous target (e.g., of an earlier file view).
+  void insert(Handle handle, Target target) {
+    std::unique_lock<std::shared_mutex> guard(mutex);
+    entries.insert_or_assign(handle, Entry{std::move(target), {}});
+  }
+
+  void erase(Handle handle) {
+    std::unique_lock<std::shared_mutex> guard(mutex);
+    entries.erase(handle);
+  }
+
+  // Returns the target of handle, or nothing if no target was recorded for it. matched is set if the datatype already
+  // matched the target.
+  std::optional<Target> find(Handle handle, MPI_Datatype type, bool& matched) {
+    std::shared_lock<std::shared_mutex> guard(mutex);
+    const auto it = entries.find(handle);
+    if (it == entries.end()) {
+      return {};
+    }
+    matched = it->second.matching.count(type) != 0;
+    return it->second.target;
+  }
+
+  void insert_match(Handle handle, MPI_Datatype type) {
+    std::unique_lock<std::shared_mutex> guard(mutex);
+    if (const auto it = entries.find(handle); it != entries.end()) {
+      it->second.matching.insert(type);
+    }
+  }
+
+  void invalidate(MPI_Datatype type) {
+    std::unique_lock<std::shared_mutex> guard(mutex);
+    for (auto& [handle, entry] : entries) {
+      entry.matching.erase(type);
+    }
+  }
+};
+
+}  // namespace typeart
+
+#endif  // TYPEART_MPI_INTERCEPTOR_TARGET_SIGNATURES_H
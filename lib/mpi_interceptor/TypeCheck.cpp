@@ -15,10 +15,12 @@
 #include "Util.h"
 
 #include <algorithm>
+#include <array>
 #include <fmt/core.h>
 #include <fmt/ostream.h>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <numeric>
 #include <utility>
 
@@ -84,26 +86,79 @@ Result<MPIType> MPIType::create(MPI_Datatype type) {
   return MPIType{type, *combiner};
 }
 
-struct Multipliers {
-  size_t type;
-  size_t buffer;
-};
+Result<std::shared_ptr<const MPIType>> MPITypeCache::get(MPI_Datatype type) {
+  {
+    std::shared_lock<std::shared_mutex> guard(mutex);
+    if (const auto it = types.find(type); it != types.end()) {
+      ++counter.hit;
+      return it->second;
+    }
+  }
+  ++counter.miss;
+
+  auto mpi_type = MPIType::create(type);
+  if (mpi_type.has_error()) {
+    return std::move(mpi_type).error();
+  }
+
+  auto decoded = std::make_shared<const MPIType>(std::move(mpi_type).value());
+  std::unique_lock<std::shared_mutex> guard(mutex);
+  // Another thread may have decoded the same type in the meantime, either result is equivalent.
+  return types.emplace(type, std::move(decoded)).first->second;
+}
+
+void MPITypeCache::invalidate(MPI_Datatype type) {
+  std::unique_lock<std::shared_mutex> guard(mutex);
+  counter.invalidated += types.erase(type);
+}
+
+std::optional<Multipliers> VerdictCache::find(const meta::di::Type& buffer_type, MPI_Datatype type) {
+  const auto type_id = buffer_type.get_id().value();
+  std::shared_lock<std::shared_mutex> guard(mutex);
+  if (const auto it = verdicts.find(type); it != verdicts.end()) {
+    if (const auto verdict = it->second.find(type_id); verdict != it->second.end()) {
+      ++counter.hit;
+      return verdict->second;
+    }
+  }
+  ++counter.miss;
+  return {};
+}
+
+void VerdictCache::insert(const meta::di::Type& buffer_type, MPI_Datatype type, const Multipliers& multipliers) {
+  const auto type_id = buffer_type.get_id().value();
+  std::unique_lock<std::shared_mutex> guard(mutex);
+  verdicts[type].insert_or_assign(type_id, multipliers);
+}
+
+void VerdictCache::invalidate(MPI_Datatype type) {
+  std::unique_lock<std::shared_mutex> guard(mutex);
+  verdicts.erase(type);
+}
 
-Result<void> check_type_and_count(const PointerInfo& pointer_info, const MPIType& type, int count);
+Result<void> check_type_and_count(const PointerInfo& pointer_info, const MPIType& type, int count,
+                                  VerdictCache* verdict_cache);
 Result<Multipliers> check_type(const PointerInfo& pointer_info, const MPIType& type);
 Result<Multipliers> check_combiner_named(const PointerInfo& pointer_info, const MPIType& type);
 Result<Multipliers> check_combiner_contiguous(const PointerInfo& pointer_info, const MPIType& type);
 Result<Multipliers> check_combiner_vector(const PointerInfo& pointer_info, const MPIType& type);
 Result<Multipliers> check_combiner_indexed_block(const PointerInfo& pointer_info, const MPIType& type);
+Result<Multipliers> check_combiner_hvector(const PointerInfo& pointer_info, const MPIType& type);
+Result<Multipliers> check_combiner_indexed(const PointerInfo& pointer_info, const MPIType& type);
+Result<Multipliers> check_combiner_hindexed(const PointerInfo& pointer_info, const MPIType& type);
+Result<Multipliers> check_combiner_hindexed_block(const PointerInfo& pointer_info, const MPIType& type);
+Result<Multipliers> check_combiner_resized(const PointerInfo& pointer_info, const MPIType& type);
 Result<Multipliers> check_combiner_struct(const PointerInfo& pointer_info, const MPIType& type);
 Result<Multipliers> check_combiner_subarray(const PointerInfo& pointer_info, const MPIType& type);
+Result<Multipliers> check_combiner_darray(const PointerInfo& pointer_info, const MPIType& type);
 
 // For a given Buffer checks that the type of the buffer fits the MPI type
 // `args.type` of this MPICall instance and that the buffer is large enough to
 // hold `args.count` elements of the MPI type.
-Result<void> check_buffer(const PointerInfo& pointer_info, const MPIType& type, int count) {
+Result<void> check_buffer(const PointerInfo& pointer_info, const MPIType& type, int count,
+                          VerdictCache* verdict_cache) {
   auto stripped_pointer_info = pointer_info.resolveAllArrayTypes();
-  auto result                = check_type_and_count(stripped_pointer_info, type, count);
+  auto result                = check_type_and_count(stripped_pointer_info, type, count, verdict_cache);
 
   if (result.has_value() || result.error()->is<InternalError>()) {
     return result;
@@ -119,7 +174,7 @@ Result<void> check_buffer(const PointerInfo& pointer_info, const MPIType& type,
   auto outer_info = stripped_pointer_info;
   while (resolve_result.has_value()) {
     auto first_member_info = resolve_result.value().stripTypedefsAndQualifiers();
-    auto subtype_result    = check_type_and_count(first_member_info, type, count);
+    auto subtype_result    = check_type_and_count(first_member_info, type, count, verdict_cache);
     if (subtype_result.has_value() || subtype_result.error()->is<InternalError>()) {
       return subtype_result;
     }
@@ -134,16 +189,51 @@ Result<void> check_buffer(const PointerInfo& pointer_info, const MPIType& type,
   return make_type_error<StructSubtypeErrors>(std::move(primary_error), std::move(subtype_errors));
 }
 
-Result<void> check_type_and_count(const PointerInfo& pointer_info, const MPIType& type, int count) {
-  auto result = check_type(pointer_info, type);
+MPI_Datatype basic_type_of(const MPIType& type) {
+  if (type.combiner.id == MPI_COMBINER_NAMED) {
+    return type.mpi_type;
+  }
+  const auto& type_args = type.combiner.type_args;
+  if (type_args.empty()) {
+    return MPI_DATATYPE_NULL;
+  }
+  const auto basic_type = basic_type_of(type_args.front());
+  const bool is_uniform = std::all_of(type_args.begin() + 1, type_args.end(),
+                                      [basic_type](const MPIType& arg) { return basic_type_of(arg) == basic_type; });
+  return is_uniform ? basic_type : MPI_DATATYPE_NULL;
+}
 
-  if (result.has_error()) {
-    return std::move(result).error();
+Result<void> check_signature(const MPIType& type, MPI_Datatype expected) {
+  const auto actual = basic_type_of(type);
+  if (expected == MPI_DATATYPE_NULL || actual == MPI_DATATYPE_NULL || expected == MPI_BYTE || actual == MPI_BYTE) {
+    return {};
+  }
+  if (actual != expected) {
+    return make_type_error<SignatureMismatch>(expected, actual);
   }
+  return {};
+}
 
-  auto multipliers  = std::move(result).value();
-  auto type_count   = static_cast<size_t>(count * multipliers.type);
-  auto buffer_count = pointer_info.resolveAllArrayTypes().getCount() * multipliers.buffer;
+Result<void> check_type_and_count(const PointerInfo& pointer_info, const MPIType& type, int count,
+                                  VerdictCache* verdict_cache) {
+  auto multipliers =
+      verdict_cache != nullptr ? verdict_cache->find(pointer_info.getType(), type.mpi_type) : std::nullopt;
+
+  if (!multipliers) {
+    auto result = check_type(pointer_info, type);
+
+    if (result.has_error()) {
+      return std::move(result).error();
+    }
+
+    multipliers = std::move(result).value();
+    if (verdict_cache != nullptr) {
+      verdict_cache->insert(pointer_info.getType(), type.mpi_type, *multipliers);
+    }
+  }
+
+  auto type_count   = static_cast<size_t>(count * multipliers->type);
+  auto buffer_count = pointer_info.resolveAllArrayTypes().getCount() * multipliers->buffer;
 
   if (type_count > buffer_count) {
     return make_type_error<InsufficientBufferSize>(buffer_count, type_count);
@@ -174,17 +264,72 @@ Result<Multipliers> check_type(const PointerInfo& pointer_info, const MPIType& t
       return check_combiner_contiguous(pointer_info, type);
     case MPI_COMBINER_VECTOR:
       return check_combiner_vector(pointer_info, type);
+    case MPI_COMBINER_HVECTOR:
+      return check_combiner_hvector(pointer_info, type);
+    case MPI_COMBINER_INDEXED:
+      return check_combiner_indexed(pointer_info, type);
+    case MPI_COMBINER_HINDEXED:
+      return check_combiner_hindexed(pointer_info, type);
     case MPI_COMBINER_INDEXED_BLOCK:
       return check_combiner_indexed_block(pointer_info, type);
+    case MPI_COMBINER_HINDEXED_BLOCK:
+      return check_combiner_hindexed_block(pointer_info, type);
+    case MPI_COMBINER_RESIZED:
+      return check_combiner_resized(pointer_info, type);
     case MPI_COMBINER_STRUCT:
       return check_combiner_struct(pointer_info, type);
     case MPI_COMBINER_SUBARRAY:
       return check_combiner_subarray(pointer_info, type);
+    case MPI_COMBINER_DARRAY:
+      return check_combiner_darray(pointer_info, type);
     default:
       return make_internal_error<UnsupportedCombiner>(combiner_name_for(type.combiner.id));
   }
 }
 
+namespace {
+
+struct BuiltinType {
+  MPI_Datatype mpi_type;
+  meta::di::Encoding encoding;
+  size_t size;
+};
+
+// The predefined MPI datatypes supported by check_combiner_named, most common first. The handles are not constant
+// expressions with all MPI implementations, hence the table (including the type sizes) is built once on first use.
+const BuiltinType* find_builtin_type(MPI_Datatype mpi_type) {
+  static const auto builtin_types = [] {
+    auto types = std::array<BuiltinType, 14>{{
+        {MPI_DOUBLE, meta::di::Encoding::Float, 0},
+        {MPI_INT, meta::di::Encoding::Signed, 0},
+        {MPI_FLOAT, meta::di::Encoding::Float, 0},
+        {MPI_LONG, meta::di::Encoding::Signed, 0},
+        {MPI_CHAR, std::is_signed_v<char> ? meta::di::Encoding::SignedChar : meta::di::Encoding::UnsignedChar, 0},
+        {MPI_UNSIGNED, meta::di::Encoding::Unsigned, 0},
+        {MPI_UNSIGNED_LONG, meta::di::Encoding::Unsigned, 0},
+        {MPI_LONG_LONG, meta::di::Encoding::Signed, 0},
+        {MPI_UNSIGNED_LONG_LONG, meta::di::Encoding::Unsigned, 0},
+        {MPI_SHORT, meta::di::Encoding::Signed, 0},
+        {MPI_UNSIGNED_SHORT, meta::di::Encoding::Unsigned, 0},
+        {MPI_SIGNED_CHAR, meta::di::Encoding::SignedChar, 0},
+        {MPI_UNSIGNED_CHAR, meta::di::Encoding::UnsignedChar, 0},
+        {MPI_LONG_DOUBLE, meta::di::Encoding::Float, 0},
+    }};
+    for (auto& builtin_type : types) {
+      MPI_Count mpi_type_size;
+      MPI_Type_size_x(builtin_type.mpi_type, &mpi_type_size);
+      builtin_type.size = static_cast<size_t>(mpi_type_size);
+    }
+    return types;
+  }();
+  const auto it = std::find_if(builtin_types.begin(), builtin_types.end(), [mpi_type](const BuiltinType& builtin_type) {
+    return builtin_type.mpi_type == mpi_type;
+  });
+  return it != builtin_types.end() ? &*it : nullptr;
+}
+
+}  // namespace
+
 // See MPICall::check_type(const Buffer&, const MPIType&)
 Result<Multipliers> check_combiner_named(const PointerInfo& pointer_info, const MPIType& type) {
   const auto mpi_type        = type.mpi_type;
@@ -198,32 +343,19 @@ Result<Multipliers> check_combiner_named(const PointerInfo& pointer_info, const
   if (basic_type == nullptr) {
     return make_type_error<BuiltinTypeMismatch>(pointer_info, type.mpi_type);
   }
-  MPI_Count mpi_type_size;
-  MPI_Type_size_x(mpi_type, &mpi_type_size);
-  if (type_size != mpi_type_size) {
-    return make_type_error<BuiltinTypeMismatch>(pointer_info, type.mpi_type);
+  const auto builtin_type = find_builtin_type(mpi_type);
+  if (builtin_type == nullptr) {
+    MPI_Count mpi_type_size;
+    MPI_Type_size_x(mpi_type, &mpi_type_size);
+    if (type_size != mpi_type_size) {
+      return make_type_error<BuiltinTypeMismatch>(pointer_info, type.mpi_type);
+    }
+    return make_internal_error<UnsupportedCombinerArgs>("unsupported predefined MPI datatype");
   }
-  const auto expected_encoding = std::unordered_map<MPI_Datatype, meta::di::Encoding>{
-      {MPI_CHAR, std::is_signed_v<char> ? meta::di::Encoding::SignedChar : meta::di::Encoding::UnsignedChar},
-      {MPI_SIGNED_CHAR, meta::di::Encoding::SignedChar},
-      {MPI_UNSIGNED_CHAR, meta::di::Encoding::UnsignedChar},
-      {MPI_SHORT, meta::di::Encoding::Signed},
-      {MPI_UNSIGNED_SHORT, meta::di::Encoding::Unsigned},
-      {MPI_INT, meta::di::Encoding::Signed},
-      {MPI_UNSIGNED, meta::di::Encoding::Unsigned},
-      {MPI_LONG, meta::di::Encoding::Signed},
-      {MPI_UNSIGNED_LONG, meta::di::Encoding::Unsigned},
-      {MPI_LONG_LONG, meta::di::Encoding::Signed},
-      {MPI_UNSIGNED_LONG_LONG, meta::di::Encoding::Unsigned},
-      {MPI_FLOAT, meta::di::Encoding::Float},
-      {MPI_DOUBLE, meta::di::Encoding::Float},
-      {MPI_LONG_DOUBLE, meta::di::Encoding::Float},
-  };
-  if (expected_encoding.at(mpi_type) == basic_type->get_encoding()) {
-    return Multipliers{1, 1};
-  } else {
+  if (type_size != builtin_type->size || builtin_type->encoding != basic_type->get_encoding()) {
     return make_type_error<BuiltinTypeMismatch>(pointer_info, type.mpi_type);
   }
+  return Multipliers{1, 1};
 }
 
 // Type check for the type combiner:
@@ -264,9 +396,11 @@ Result<Multipliers> check_combiner_vector(const PointerInfo& pointer_info, const
   // start of each consecutive block is `stride` elements of `oldtype` apart
   // and each block consists of `blocklength` elements of oldtype.
   // We therefore check the buffer's type against `oldtype` and multiply the
-  // resulting count by `(count - 1) * stride + blocklength`.
+  // resulting count by `(count - 1) * stride + blocklength`, or by 0 for an
+  // empty vector (which would otherwise wrap around).
   return check_type(pointer_info, type.combiner.type_args[0]).map([&](auto multipliers) {
-    return Multipliers{multipliers.type * ((count - 1) * stride + blocklength), multipliers.buffer};
+    const auto elements = count == 0 ? 0 : (count - 1) * stride + blocklength;
+    return Multipliers{multipliers.type * elements, multipliers.buffer};
   });
 }
 
@@ -280,6 +414,14 @@ Result<Multipliers> check_combiner_indexed_block(const PointerInfo& pointer_info
   const auto count                  = type.combiner.integer_args[0];
   const auto blocklength            = type.combiner.integer_args[1];
   const auto array_of_displacements = type.combiner.integer_args.begin() + 2;
+
+  if (count == 0) {
+    // An empty type, see MPI_Type_vector.
+    return check_type(pointer_info, type.combiner.type_args[0]).map([&](auto multipliers) {
+      return Multipliers{0, multipliers.buffer};
+    });
+  }
+
   const auto [min_displacement, max_displacement] =
       std::minmax_element(array_of_displacements, array_of_displacements + count);
 
@@ -298,6 +440,200 @@ Result<Multipliers> check_combiner_indexed_block(const PointerInfo& pointer_info
       });
 }
 
+// Converts the byte distance `bytes` of a type combiner argument into a number
+// of elements of `oldtype`. Distances which are not a multiple of the extent of
+// `oldtype` cannot be expressed in elements of the buffer's type.
+Result<MPI_Aint> extent_count(const MPIType& oldtype, MPI_Aint bytes, const char* combiner_name) {
+  MPI_Aint lower_bound;
+  MPI_Aint extent;
+  const auto mpierr = MPI_Type_get_extent(oldtype.mpi_type, &lower_bound, &extent);
+
+  if (mpierr != MPI_SUCCESS) {
+    return make_internal_error<MPIError>("MPI_Type_get_extent", error_message_for(mpierr));
+  }
+
+  if (extent <= 0 || bytes % extent != 0) {
+    return make_internal_error<UnsupportedCombinerArgs>(
+        fmt::format("byte displacements for {} which are not a multiple of the extent of the old type are currently "
+                    "not supported",
+                    combiner_name));
+  }
+
+  return bytes / extent;
+}
+
+// Type check for the type combiner:
+// int MPI_Type_create_hvector(int count, int blocklength, MPI_Aint stride,
+//     MPI_Datatype oldtype, MPI_Datatype *newtype)
+//
+// See MPICall::check_type(const Buffer&, const MPIType&) for an explanation of
+// the arguments and the return type.
+Result<Multipliers> check_combiner_hvector(const PointerInfo& pointer_info, const MPIType& type) {
+  const auto count       = type.combiner.integer_args[0];
+  const auto blocklength = type.combiner.integer_args[1];
+  const auto& oldtype    = type.combiner.type_args[0];
+
+  if (type.combiner.address_args[0] < 0) {
+    return make_internal_error<UnsupportedCombinerArgs>(
+        "negative strides for MPI_Type_create_hvector are currently not supported");
+  }
+
+  // Same as MPI_Type_vector, but the stride is given in bytes instead of
+  // elements of `oldtype`.
+  auto stride = extent_count(oldtype, type.combiner.address_args[0], "MPI_Type_create_hvector");
+  if (stride.has_error()) {
+    return std::move(stride).error();
+  }
+
+  return check_type(pointer_info, oldtype).map([&, stride = *stride](auto multipliers) {
+    const auto elements = count == 0 ? 0 : (count - 1) * stride + blocklength;
+    return Multipliers{multipliers.type * elements, multipliers.buffer};
+  });
+}
+
+// Type check for the type combiner:
+// int MPI_Type_indexed(int count, const int array_of_blocklengths[],
+//     const int array_of_displacements[], MPI_Datatype oldtype,
+//     MPI_Datatype *newtype)
+//
+// See MPICall::check_type(const Buffer&, const MPIType&) for an explanation of
+// the arguments and the return type.
+Result<Multipliers> check_combiner_indexed(const PointerInfo& pointer_info, const MPIType& type) {
+  const auto count                  = type.combiner.integer_args[0];
+  const auto array_of_blocklengths  = type.combiner.integer_args.begin() + 1;
+  const auto array_of_displacements = array_of_blocklengths + count;
+
+  auto block_end = MPI_Aint{0};
+  for (int i = 0; i < count; ++i) {
+    if (array_of_displacements[i] < 0) {
+      return make_internal_error<UnsupportedCombinerArgs>(
+          "negative displacements for MPI_Type_indexed are currently not supported");
+    }
+    block_end = std::max<MPI_Aint>(block_end, array_of_displacements[i] + array_of_blocklengths[i]);
+  }
+
+  // Similar to MPI_Type_create_indexed_block but with a separate blocklength
+  // for each block. We therefore check the buffer's type against `oldtype` and
+  // multiply the resulting count by the end of the last block.
+  return check_type(pointer_info, type.combiner.type_args[0]).map([&](auto multipliers) {
+    return Multipliers{multipliers.type * block_end, multipliers.buffer};
+  });
+}
+
+// Type check for the type combiner:
+// int MPI_Type_create_hindexed(int count, const int array_of_blocklengths[],
+//     const MPI_Aint array_of_displacements[], MPI_Datatype oldtype,
+//     MPI_Datatype *newtype)
+//
+// See MPICall::check_type(const Buffer&, const MPIType&) for an explanation of
+// the arguments and the return type.
+Result<Multipliers> check_combiner_hindexed(const PointerInfo& pointer_info, const MPIType& type) {
+  const auto count                   = type.combiner.integer_args[0];
+  const auto array_of_blocklengths   = type.combiner.integer_args.begin() + 1;
+  const auto& array_of_displacements = type.combiner.address_args;
+  const auto& oldtype                = type.combiner.type_args[0];
+
+  // Same as MPI_Type_indexed, but the displacements are given in bytes.
+  auto block_end = MPI_Aint{0};
+  for (int i = 0; i < count; ++i) {
+    if (array_of_displacements[i] < 0) {
+      return make_internal_error<UnsupportedCombinerArgs>(
+          "negative displacements for MPI_Type_create_hindexed are currently not supported");
+    }
+    auto displacement = extent_count(oldtype, array_of_displacements[i], "MPI_Type_create_hindexed");
+    if (displacement.has_error()) {
+      return std::move(displacement).error();
+    }
+    block_end = std::max<MPI_Aint>(block_end, *displacement + array_of_blocklengths[i]);
+  }
+
+  return check_type(pointer_info, oldtype).map([&](auto multipliers) {
+    return Multipliers{multipliers.type * block_end, multipliers.buffer};
+  });
+}
+
+// Type check for the type combiner:
+// int MPI_Type_create_hindexed_block(int count, int blocklength, const
+//     MPI_Aint array_of_displacements[], MPI_Datatype oldtype,
+//     MPI_Datatype *newtype)
+//
+// See MPICall::check_type(const Buffer&, const MPIType&) for an explanation of
+// the arguments and the return type.
+Result<Multipliers> check_combiner_hindexed_block(const PointerInfo& pointer_info, const MPIType& type) {
+  const auto count                   = type.combiner.integer_args[0];
+  const auto blocklength             = type.combiner.integer_args[1];
+  const auto& array_of_displacements = type.combiner.address_args;
+  const auto& oldtype                = type.combiner.type_args[0];
+
+  if (count == 0) {
+    // An empty type, see MPI_Type_vector.
+    return check_type(pointer_info, oldtype).map([&](auto multipliers) {
+      return Multipliers{0, multipliers.buffer};
+    });
+  }
+
+  // Same as MPI_Type_create_indexed_block, but the displacements are given in
+  // bytes.
+  auto max_displacement = MPI_Aint{0};
+  for (int i = 0; i < count; ++i) {
+    if (array_of_displacements[i] < 0) {
+      return make_internal_error<UnsupportedCombinerArgs>(
+          "negative displacements for MPI_Type_create_hindexed_block are currently not supported");
+    }
+    auto displacement = extent_count(oldtype, array_of_displacements[i], "MPI_Type_create_hindexed_block");
+    if (displacement.has_error()) {
+      return std::move(displacement).error();
+    }
+    max_displacement = std::max(max_displacement, *displacement);
+  }
+
+  return check_type(pointer_info, oldtype).map([&](auto multipliers) {
+    return Multipliers{multipliers.type * (max_displacement + blocklength), multipliers.buffer};
+  });
+}
+
+// Type check for the type combiner:
+// int MPI_Type_create_resized(MPI_Datatype oldtype, MPI_Aint lb,
+//     MPI_Aint extent, MPI_Datatype *newtype)
+//
+// See MPICall::check_type(const Buffer&, const MPIType&) for an explanation of
+// the arguments and the return type.
+Result<Multipliers> check_combiner_resized(const PointerInfo& pointer_info, const MPIType& type) {
+  const auto lower_bound = type.combiner.address_args[0];
+  const auto extent      = type.combiner.address_args[1];
+
+  if (lower_bound != 0) {
+    return make_internal_error<UnsupportedCombinerArgs>(
+        "non-zero lower bounds for MPI_Type_create_resized are currently not supported");
+  }
+
+  auto result = check_type(pointer_info, type.combiner.type_args[0]);
+  if (result.has_error()) {
+    return result;
+  }
+
+  // The resized type only changes the distance between consecutive elements.
+  // The multipliers require `count` times the elements of one element, which
+  // only holds if the extent equals the span of `oldtype` in the buffer. Other
+  // extents place consecutive elements `extent` bytes apart, i.e., `count`
+  // elements require `(count - 1) * extent` bytes plus the span of `oldtype`
+  // (e.g., a strided column resized to scatter a matrix), which a multiplier
+  // per element cannot express. The unit of the multipliers is an element of
+  // the buffer's type (or a byte for MPI_BYTE).
+  const auto multipliers = std::move(result).value();
+  const auto type_size   = pointer_info.resolveAllArrayTypes().getType().get_size_in_bits() / 8;
+  const auto unit_size   = static_cast<MPI_Aint>(type_size / multipliers.buffer);
+
+  if (extent <= 0 || unit_size == 0 || extent % unit_size != 0 ||
+      static_cast<size_t>(extent / unit_size) != multipliers.type) {
+    return make_internal_error<UnsupportedCombinerArgs>(
+        "extents for MPI_Type_create_resized which differ from the span of the old type in the buffer are currently "
+        "not supported");
+  }
+
+  return multipliers;
+}
+
 void collect_members(const meta::di::StructureType& current_struct, size_t inherited_offset,
                      std::vector<std::pair<const meta::di::Member*, size_t>>& members) {
   for (const auto& inheritance : current_struct.get_base_classes()) {
@@ -398,4 +734,24 @@ Result<Multipliers> check_combiner_subarray(const PointerInfo& pointer_info, con
   });
 }
 
+// Type check for the type combiner:
+// int MPI_Type_create_darray(int size, int rank, int ndims, const int
+//     array_of_gsizes[], const int array_of_distribs[], const int
+//     array_of_dargs[], const int array_of_psizes[], int order, MPI_Datatype
+//     oldtype, MPI_Datatype *newtype)
+//
+// See MPICall::check_type(const Buffer&, const MPIType&) for an explanation of
+// the arguments and the return type.
+Result<Multipliers> check_combiner_darray(const PointerInfo& pointer_info, const MPIType& type) {
+  const auto ndims               = type.combiner.integer_args[2];
+  const auto array_of_gsizes     = type.combiner.integer_args.begin() + 3;
+  const auto array_element_count = std::accumulate(array_of_gsizes, array_of_gsizes + ndims, 1, std::multiplies{});
+  // Like MPI_Type_create_subarray, the distributed array type describes the
+  // part of the global array owned by `rank` at its position within the
+  // global array, so the buffer must be large enough to hold the global array.
+  return check_type(pointer_info, type.combiner.type_args[0]).map([&](auto multipliers) {
+    return Multipliers{multipliers.type * array_element_count, multipliers.buffer};
+  });
+}
+
 }  // namespace typeart
@@ -14,16 +14,20 @@
 #define TYPEART_MPI_INTERCEPTOR_TYPE_CHECK_H
 
 #include "Error.h"
+#include "Stats.h"
 #include "Util.h"
 
 #include <atomic>
 #include <cstddef>
 #include <cstdio>
 #include <mpi.h>
+#include <memory>
 #include <optional>
+#include <shared_mutex>
 #include <string>
 #include <typeart/TypeART.hpp>
 #include <typeart/support/System.hpp>
+#include <unordered_map>
 #include <vector>
 
 namespace typeart {
@@ -48,7 +52,60 @@ struct MPIType {
   static Result<MPIType> create(MPI_Datatype type);
 };
 
-Result<void> check_buffer(const PointerInfo& pointer_info, const MPIType& type, int count);
+// Maps MPI datatype handles to their decoded MPIType, so that the envelope and contents of a (derived) datatype are
+// only queried once. Handles may be reused by MPI after MPI_Type_free, hence, entries must be invalidated then.
+class MPITypeCache {
+  std::shared_mutex mutex;
+  std::unordered_map<MPI_Datatype, std::shared_ptr<const MPIType>> types;
+  TypeCacheCounter counter;
+
+ public:
+  Result<std::shared_ptr<const MPIType>> get(MPI_Datatype type);
+
+  void invalidate(MPI_Datatype type);
+
+  [[nodiscard]] const TypeCacheCounter& get_counter() const {
+    return counter;
+  }
+};
+
+// The number of elements of the buffer's type required to represent one element of the MPI type (type) and vice
+// versa (buffer), see check_type in TypeCheck.cpp.
+struct Multipliers {
+  size_t type;
+  size_t buffer;
+};
+
+// Memoizes successful type checks per (buffer type, MPI datatype handle), so that only the element count is compared
+// for types which already matched. check_buffer only queries canonical buffer types. Type errors are not memoized,
+// their diagnostics refer to the checked buffer. Like MPITypeCache, entries must be invalidated on MPI_Type_free.
+class VerdictCache {
+  std::shared_mutex mutex;
+  std::unordered_map<MPI_Datatype, std::unordered_map<meta::meta_id_t::value_type, Multipliers>> verdicts;
+  VerdictCacheCounter counter;
+
+ public:
+  std::optional<Multipliers> find(const meta::di::Type& buffer_type, MPI_Datatype type);
+
+  void insert(const meta::di::Type& buffer_type, MPI_Datatype type, const Multipliers& multipliers);
+
+  void invalidate(MPI_Datatype type);
+
+  [[nodiscard]] const VerdictCacheCounter& get_counter() const {
+    return counter;
+  }
+};
+
+Result<void> check_buffer(const PointerInfo& pointer_info, const MPIType& type, int count,
+                          VerdictCache* verdict_cache = nullptr);
+
+// The predefined datatype all elements of the type signature are of (e.g., MPI_DOUBLE for a vector of MPI_DOUBLE), or
+// MPI_DATATYPE_NULL if the type is built from several predefined datatypes.
+MPI_Datatype basic_type_of(const MPIType& type);
+
+// Checks that the type signature of type consists of elements of the predefined datatype expected. MPI_BYTE matches
+// any type signature, and types built from several predefined datatypes are not checked.
+Result<void> check_signature(const MPIType& type, MPI_Datatype expected);
 
 }  // namespace typeart
 
@@ -33,6 +33,11 @@ static cl::opt<bool> cl_typeart_instrument_stack_lifetime(
     "typeart-stack-lifetime", cl::desc("Instrument lifetime.start intrinsic instead of alloca."), cl::init(true),
     cl::cat(typeart_category));
 
+static cl::opt<bool> cl_typeart_instrument_heap_bulk(
+    "typeart-heap-bulk",
+    cl::desc("Register heap allocations within simple loops in bulk (tracker only)."), cl::init(false),
+    cl::cat(typeart_category));
+
 static cl::OptionCategory typeart_meminstfinder_category(
     "TypeART memory instruction finder", "These options control which memory instructions are collected/filtered.");
 
@@ -126,6 +131,10 @@ bool getInstrumentHeap() {
   return cl_typeart_instrument_heap.getValue();
 }
 
+bool getInstrumentHeapBulk() {
+  return cl_typeart_instrument_heap_bulk.getValue();
+}
+
 bool getPrintStats() {
   return cl_typeart_stats.getValue();
 }
@@ -11,6 +11,7 @@ bool getInstrumentGlobal();
 bool getInstrumentStack();
 bool getInstrumentStackLifetime();
 bool getInstrumentHeap();
+bool getInstrumentHeapBulk();
 bool getPrintStats();
 
 }  // namespace typeart::cl
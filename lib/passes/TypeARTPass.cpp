@@ -84,8 +84,8 @@ bool TypeArtPass::doInitialization(llvm::Module& m) {
       std::make_unique<instrumentation::allocator::InstrumentationStrategy>(m, cl::getInstrumentStackLifetime());
 #elifdef TYPEART_USE_TRACKER
   auto parser = std::make_unique<instrumentation::tracker::ArgumentParser>(m, *converter);
-  auto strategy =
-      std::make_unique<instrumentation::tracker::InstrumentationStrategy>(m, cl::getInstrumentStackLifetime());
+  auto strategy = std::make_unique<instrumentation::tracker::InstrumentationStrategy>(
+      m, cl::getInstrumentStackLifetime(), cl::getInstrumentHeapBulk());
 #else
   auto parser = std::make_unique<instrumentation::hybrid::ArgumentParser>(m, *converter);
   auto strategy =
@@ -44,6 +44,10 @@ llvm::Type* InstrumentationHelper::getTypeFor(IType id) {
       return Type::getInt32Ty(c);
     case IType::alloc_id:
       return Type::getInt32Ty(c);
+    case IType::ptr_list:
+      return PointerType::getUnqual(getTypeFor(IType::ptr));
+    case IType::extent_list:
+      return PointerType::getUnqual(getTypeFor(IType::extent));
     default:
       LOG_WARNING("Unknown IType selected.");
       return nullptr;
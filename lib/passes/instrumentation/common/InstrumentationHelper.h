@@ -31,6 +31,8 @@ enum class IType {
   extent,       // Type for identifying an array length
   stack_count,  // Type for identifying a count of stack alloca instructions
   alloc_id,
+  ptr_list,     // Type for passing an array of pointers to the runtime
+  extent_list,  // Type for passing an array of array lengths to the runtime
 };
 
 class InstrumentationHelper {
@@ -76,6 +76,10 @@ TypeArtFunctions::TypeArtFunctions(llvm::Module& m) {
   tracker_free                = make_function(m, "typeart_tracker_free", free_arg_types);
   tracker_leave_scope         = make_function(m, "typeart_tracker_leave_scope", leavescope_arg_types);
 
+  auto alloc_bulk_arg_types =
+      instrumentation_helper.make_parameters(IType::ptr_list, IType::alloc_id, IType::extent_list, IType::extent);
+  tracker_alloc_bulk = make_function(m, "typeart_tracker_alloc_bulk", alloc_bulk_arg_types);
+
   tracker_alloc_omp        = make_function(m, "typeart_tracker_alloc_omp", alloc_arg_types);
   tracker_alloc_stacks_omp = make_function(m, "typeart_tracker_alloc_stack_omp", alloc_arg_types);
   tracker_free_omp         = make_function(m, "typeart_tracker_free_omp", free_arg_types);
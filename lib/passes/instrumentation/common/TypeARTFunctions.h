@@ -24,6 +24,7 @@ struct TypeArtFunctions {
   TypeArtFunctions(const TypeArtFunctions&) = default;
 
   llvm::Function* tracker_alloc        = nullptr;
+  llvm::Function* tracker_alloc_bulk   = nullptr;
   llvm::Function* tracker_alloc_global = nullptr;
   llvm::Function* tracker_alloc_stack  = nullptr;
   llvm::Function* tracker_free         = nullptr;
@@ -46,7 +46,7 @@ InstrumentationStrategy::InstrumentationStrategy(llvm::Module& m, bool instrumen
     : instrumentation::InstrumentationStrategy(),
       type_art_functions(m),
       instr_helper(m),
-      tracker_instrumentation(m, false),
+      tracker_instrumentation(m, false, false),
       allocator_instrumentation(m, false),
       instrument_lifetime(instrument_lifetime) {
 }
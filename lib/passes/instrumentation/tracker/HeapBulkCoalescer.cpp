@@ -0,0 +1,163 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "HeapBulkCoalescer.h"
+
+#include "analysis/MemOpData.h"
+#include "support/Logger.hpp"
+#include "support/OmpUtil.h"
+#include "support/Util.h"
+
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/IR/BasicBlock.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/IntrinsicInst.h"
+#include "llvm/Support/Casting.h"
+#include "llvm/Transforms/Utils/BasicBlockUtils.h"
+
+#include <cassert>
+
+using namespace llvm;
+
+namespace typeart::instrumentation::tracker {
+
+namespace {
+bool isDeferrable(const MallocData& malloc) {
+  // Realloc-like calls free memory (observable by the runtime), array cookies and invokes complicate the
+  // insertion point, keep it simple.
+  switch (malloc.kind) {
+    case MemOpKind::MallocLike:
+    case MemOpKind::CallocLike:
+    case MemOpKind::NewLike:
+    case MemOpKind::AlignedAllocLike:
+      return !malloc.is_invoke && !malloc.array_cookie.hasValue();
+    default:
+      return false;
+  }
+}
+
+bool isSimpleLoop(const Loop& loop, const SmallPtrSetImpl<const CallBase*>& deferrable_calls) {
+  if (loop.getLoopPreheader() == nullptr || loop.getLoopLatch() == nullptr || loop.getExitingBlock() == nullptr ||
+      loop.getUniqueExitBlock() == nullptr) {
+    return false;
+  }
+  for (const auto* block : loop.blocks()) {
+    for (const auto& inst : *block) {
+      const auto* call = dyn_cast<CallBase>(&inst);
+      if (call == nullptr || isa<IntrinsicInst>(call) || deferrable_calls.count(call) > 0) {
+        continue;
+      }
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+HeapBulkCoalescer::HeapBulkCoalescer(llvm::Function& f, const HeapArgList& heap,
+                                     common::InstrumentationHelper& instr_helper,
+                                     common::TypeArtFunctions& type_art_functions)
+    : f(&f), instr_helper(&instr_helper), type_art_functions(&type_art_functions), dom_tree(f), loop_info(dom_tree) {
+  if (util::omp::isOmpContext(&f)) {
+    return;
+  }
+
+  SmallPtrSet<const CallBase*, 16> deferrable_calls;
+  for (const auto& [malloc, args] : heap) {
+    if (isDeferrable(malloc)) {
+      deferrable_calls.insert(malloc.call);
+    }
+  }
+
+  // The loops must be classified before any of them is transformed.
+  DenseMap<Loop*, bool> simple_loops;
+  for (const auto* call : deferrable_calls) {
+    auto* loop = loop_info.getLoopFor(call->getParent());
+    if (loop == nullptr) {
+      continue;
+    }
+    auto [it, inserted] = simple_loops.try_emplace(loop, false);
+    if (inserted) {
+      it->second = isSimpleLoop(*loop, deferrable_calls);
+    }
+    if (it->second) {
+      deferred[call] = loop;
+    }
+  }
+}
+
+bool HeapBulkCoalescer::canDefer(const MallocData& malloc) const {
+  return deferred.count(malloc.call) > 0;
+}
+
+HeapBulkCoalescer::Buffer HeapBulkCoalescer::makeBuffer() {
+  IRBuilder<> IRB(&*f->getEntryBlock().getFirstInsertionPt());
+  auto* ptr_type    = instr_helper->getTypeFor(IType::ptr);
+  auto* extent_type = instr_helper->getTypeFor(IType::extent);
+
+  Buffer buffer;
+  buffer.addrs  = IRB.CreateAlloca(ArrayType::get(ptr_type, buffer_size), nullptr, "__ta_bulk_addrs");
+  buffer.counts = IRB.CreateAlloca(ArrayType::get(extent_type, buffer_size), nullptr, "__ta_bulk_counts");
+  buffer.fill   = IRB.CreateAlloca(extent_type, nullptr, "__ta_bulk_fill");
+  IRB.CreateStore(instr_helper->getConstantFor(IType::extent, 0), buffer.fill);
+  return buffer;
+}
+
+void HeapBulkCoalescer::emitFlush(llvm::IRBuilder<>& irb, const Buffer& buffer, llvm::Value* meta_id,
+                                  llvm::Value* fill) const {
+  auto* addrs  = irb.CreateConstInBoundsGEP2_64(buffer.addrs->getAllocatedType(), buffer.addrs, 0, 0);
+  auto* counts = irb.CreateConstInBoundsGEP2_64(buffer.counts->getAllocatedType(), buffer.counts, 0, 0);
+  irb.CreateCall(type_art_functions->tracker_alloc_bulk, ArrayRef<Value*>{addrs, meta_id, counts, fill});
+  irb.CreateStore(instr_helper->getConstantFor(IType::extent, 0), buffer.fill);
+}
+
+void HeapBulkCoalescer::defer(const MallocData& malloc, llvm::Instruction* insert_before, llvm::Value* meta_id,
+                              llvm::Value* element_count) {
+  auto* loop = deferred.lookup(malloc.call);
+  assert(loop != nullptr && "Allocation cannot be deferred");
+
+  const auto buffer = makeBuffer();
+  auto* extent_type = instr_helper->getTypeFor(IType::extent);
+  auto* zero        = instr_helper->getConstantFor(IType::extent, 0);
+
+  // buffer[fill] = (addr, count); ++fill
+  IRBuilder<> IRB(insert_before);
+  auto* fill       = IRB.CreateLoad(extent_type, buffer.fill);
+  auto* addr_slot  = IRB.CreateInBoundsGEP(buffer.addrs->getAllocatedType(), buffer.addrs, {zero, fill});
+  auto* count_slot = IRB.CreateInBoundsGEP(buffer.counts->getAllocatedType(), buffer.counts, {zero, fill});
+  IRB.CreateStore(IRB.CreateBitOrPointerCast(malloc.call, instr_helper->getTypeFor(IType::ptr)), addr_slot);
+  IRB.CreateStore(IRB.CreateZExtOrTrunc(element_count, extent_type), count_slot);
+  auto* next_fill = IRB.CreateAdd(fill, instr_helper->getConstantFor(IType::extent, 1));
+  IRB.CreateStore(next_fill, buffer.fill);
+
+  // if (fill == buffer_size) flush
+  auto* is_full = IRB.CreateICmpEQ(next_fill, instr_helper->getConstantFor(IType::extent, buffer_size));
+  auto* then_term =
+      SplitBlockAndInsertIfThen(is_full, insert_before, /*Unreachable=*/false, nullptr, &dom_tree, &loop_info);
+  IRBuilder<> FlushB(then_term);
+  emitFlush(FlushB, buffer, meta_id, next_fill);
+
+  // Register the remainder once the loop is left
+  SmallVector<BasicBlock*, 4> exits;
+  loop->getUniqueExitBlocks(exits);
+  for (auto* exit : exits) {
+    IRBuilder<> ExitB(&*exit->getFirstInsertionPt());
+    auto* pending = ExitB.CreateLoad(extent_type, buffer.fill);
+    emitFlush(ExitB, buffer, meta_id, pending);
+  }
+
+  LOG_DEBUG("Deferred heap allocation callback to bulk registration: {}", util::dump(*malloc.call));
+}
+
+}  // namespace typeart::instrumentation::tracker
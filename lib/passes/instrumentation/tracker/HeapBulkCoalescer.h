@@ -0,0 +1,67 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_HEAPBULKCOALESCER_H
+#define TYPEART_HEAPBULKCOALESCER_H
+
+#include "../TypeARTInstrumentation.h"
+#include "../common/InstrumentationHelper.h"
+#include "../common/TypeARTFunctions.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Analysis/LoopInfo.h"
+#include "llvm/IR/Dominators.h"
+#include "llvm/IR/IRBuilder.h"
+
+namespace typeart::instrumentation::tracker {
+
+// Defers the heap allocation callbacks of allocations within simple loops of a function.
+// Instead of calling typeart_tracker_alloc per iteration, the (address, count) pairs of an
+// allocation call site are collected in a fixed size stack buffer. The buffer is passed to
+// typeart_tracker_alloc_bulk whenever it is full and on every exit of the loop.
+// A loop only qualifies if it does not contain any other call, i.e., the runtime cannot
+// observe the deferred registration.
+class HeapBulkCoalescer {
+  static constexpr unsigned buffer_size = 64;
+
+  struct Buffer {
+    llvm::AllocaInst* addrs{nullptr};
+    llvm::AllocaInst* counts{nullptr};
+    llvm::AllocaInst* fill{nullptr};
+  };
+
+  llvm::Function* f;
+  common::InstrumentationHelper* instr_helper;
+  common::TypeArtFunctions* type_art_functions;
+  llvm::DominatorTree dom_tree;
+  llvm::LoopInfo loop_info;
+  // Allocation call -> loop the callback is deferred to.
+  llvm::DenseMap<const llvm::CallBase*, llvm::Loop*> deferred;
+
+  Buffer makeBuffer();
+  void emitFlush(llvm::IRBuilder<>& irb, const Buffer& buffer, llvm::Value* meta_id, llvm::Value* fill) const;
+
+ public:
+  HeapBulkCoalescer(llvm::Function& f, const HeapArgList& heap, common::InstrumentationHelper& instr_helper,
+                    common::TypeArtFunctions& type_art_functions);
+
+  // True if the callback for the allocation can be deferred.
+  bool canDefer(const MallocData& malloc) const;
+
+  // Emits the buffering of the allocation at insert_before, in place of the tracker_alloc callback.
+  void defer(const MallocData& malloc, llvm::Instruction* insert_before, llvm::Value* meta_id,
+             llvm::Value* element_count);
+};
+
+}  // namespace typeart::instrumentation::tracker
+
+#endif  // TYPEART_HEAPBULKCOALESCER_H
@@ -12,6 +12,7 @@
 
 #include "InstrumentationStrategy.h"
 
+#include "HeapBulkCoalescer.h"
 #include "TransformUtil.h"
 #include "analysis/MemOpData.h"
 #include "support/Logger.hpp"
@@ -33,22 +34,28 @@
 #include "llvm/Support/raw_ostream.h"
 #include "llvm/Transforms/Utils/ModuleUtils.h"
 
+#include <optional>
 #include <string>
 
 using namespace llvm;
 
 namespace typeart::instrumentation::tracker {
 
-InstrumentationStrategy::InstrumentationStrategy(llvm::Module& m, bool instrument_lifetime)
+InstrumentationStrategy::InstrumentationStrategy(llvm::Module& m, bool instrument_lifetime, bool coalesce_heap)
     : instrumentation::InstrumentationStrategy(),
       module(&m),
       type_art_functions(m),
       instr_helper(m),
-      instrument_lifetime(instrument_lifetime) {
+      instrument_lifetime(instrument_lifetime),
+      coalesce_heap(coalesce_heap) {
 }
 
 size_t InstrumentationStrategy::instrumentHeap(const HeapArgList& heap) {
   size_t counter{0};
+  std::optional<HeapBulkCoalescer> coalescer;
+  if (coalesce_heap && !heap.empty()) {
+    coalescer.emplace(*heap.front().mem_data.call->getFunction(), heap, instr_helper, type_art_functions);
+  }
   for (const auto& [malloc, args] : heap) {
     auto kind                = malloc.kind;
     Instruction* malloc_call = args.get_as<Instruction>(ArgMap::ID::pointer);
@@ -116,6 +123,12 @@ size_t InstrumentationStrategy::instrumentHeap(const HeapArgList& heap) {
         continue;
     }
 
+    if (coalescer && coalescer->canDefer(malloc)) {
+      coalescer->defer(malloc, insertBefore, metaIdConst, elementCount);
+      ++counter;
+      continue;
+    }
+
     const auto callback = omp ? type_art_functions.tracker_alloc_omp : type_art_functions.tracker_alloc;
     IRB.CreateCall(callback, ArrayRef<Value*>{malloc_call, metaIdConst, elementCount});
     ++counter;
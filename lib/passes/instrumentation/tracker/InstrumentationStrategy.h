@@ -23,9 +23,10 @@ class InstrumentationStrategy final : public instrumentation::InstrumentationStr
   common::TypeArtFunctions type_art_functions;
   common::InstrumentationHelper instr_helper;
   bool instrument_lifetime{false};
+  bool coalesce_heap{false};
 
  public:
-  InstrumentationStrategy(llvm::Module& m, bool instrument_lifetime);
+  InstrumentationStrategy(llvm::Module& m, bool instrument_lifetime, bool coalesce_heap = false);
   size_t instrumentHeap(const HeapArgList& heap) override;
   size_t instrumentFree(const FreeArgList& frees) override;
   size_t instrumentStack(const StackArgList& stack) override;
@@ -32,8 +32,9 @@ namespace typeart::softcounter {
 namespace memory {
 struct MemOverhead {
   static constexpr auto pointerMapSize = sizeof(tracker::RuntimeT::PointerMap);  // Map overhead
-  static constexpr auto perNodeSizeMap =
-      64U + sizeof(tracker::RuntimeT::MapEntry);  // rough estimate, not applicable to btree; 64U is internal node size
+  // rough estimate, not applicable to btree; 64U is internal node size.
+  // MapEntry holds the compact tracker::AllocationRecord (meta id, count), not a full PointerInfo.
+  static constexpr auto perNodeSizeMap = 64U + sizeof(tracker::RuntimeT::MapEntry);
   static constexpr auto stackVectorSize  = sizeof(tracker::RuntimeT::Stack);       // Stack overhead
   static constexpr auto perNodeSizeStack = sizeof(tracker::RuntimeT::StackEntry);  // Stack allocs
   double stack{0};
@@ -69,6 +70,8 @@ void serialize(const Recorder& r, std::ostringstream& buf) {
     t.put(Row::make("Addresses re-used", r.getAddrReuses()));
     t.put(Row::make("Addresses missed", r.getAddrMissing()));
     t.put(Row::make("Distinct Addresses missed", r.getMissing().size()));
+    t.put(Row::make("Lookup cache hit/miss", r.getLookupCacheHits(), r.getLookupCacheMisses()));
+    t.put(Row::make("Subtype memo hit/miss", r.getSubtypeMemoHits(), r.getSubtypeMemoMisses()));
     t.put(Row::make("Total free heap", r.getHeapAllocsFree(), r.getHeapArrayFree()));
     t.put(Row::make("Total free stack", r.getStackAllocsFree(), r.getStackArrayFree()));
     t.put(Row::make("OMP Stack/Heap/Free", r.getOmpStackCalls(), r.getOmpHeapCalls(), r.getOmpFreeCalls()));
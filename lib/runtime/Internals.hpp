@@ -5,6 +5,14 @@
 
 namespace typeart {
 
+namespace layout {
+class LayoutTable;
+}  // namespace layout
+
+namespace types {
+class TypeTable;
+}  // namespace types
+
 struct ScopeGuard final {
   ScopeGuard();
   ~ScopeGuard();
@@ -20,5 +28,7 @@ struct ScopeGuard final {
 
 Recorder& getRecorder();
 meta::Database& getDatabase();
+const layout::LayoutTable& getLayoutTable();
+const types::TypeTable& getTypeTable();
 
 }  // namespace typeart
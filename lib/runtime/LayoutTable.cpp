@@ -0,0 +1,249 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "LayoutTable.hpp"
+
+#include "support/Logger.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace typeart::layout {
+
+namespace {
+inline size_t index_for(const meta::Meta& meta) {
+  return static_cast<size_t>(meta.get_id().value()) - 1;
+}
+}  // namespace
+
+LayoutTable LayoutTable::build(const meta::Database& db) {
+  LayoutTable table;
+  const auto& metas = db.getMeta();
+  table.states.resize(metas.size(), State::None);
+  table.layouts.resize(metas.size());
+
+  size_t flattened{0};
+  for (const auto& meta : metas) {
+    if (const auto* structure = meta::dyn_cast<meta::di::StructureType>(meta.get()); structure != nullptr) {
+      flattened += table.layout_for(*structure) != nullptr ? 1 : 0;
+    }
+  }
+  LOG_DEBUG("Flattened the layout of {} structure types", flattened);
+  return table;
+}
+
+const Layout* LayoutTable::layout_for(const meta::di::StructureType& structure) {
+  const auto index = index_for(structure);
+  if (index >= states.size()) {
+    return nullptr;
+  }
+  switch (states[index]) {
+    case State::Flat:
+      return &layouts[index];
+    case State::Pending:
+      // Only possible for (invalid) recursive structure types
+      [[fallthrough]];
+    case State::Unsupported:
+      return nullptr;
+    case State::None:
+      break;
+  }
+
+  states[index] = State::Pending;
+  Layout layout;
+  member_path path;
+  bool success = flatten(structure, 0, path, layout);
+  if (success) {
+    std::sort(layout.entries.begin(), layout.entries.end(),
+              [](const Entry& lhs, const Entry& rhs) { return lhs.offset < rhs.offset; });
+    const auto overlap = std::adjacent_find(layout.entries.begin(), layout.entries.end(),
+                                            [](const Entry& lhs, const Entry& rhs) { return lhs.end() > rhs.offset; });
+    success = overlap == layout.entries.end();
+  }
+  if (!success) {
+    LOG_DEBUG("Layout of {} is not flattened", structure.get_pretty_name());
+    states[index] = State::Unsupported;
+    return nullptr;
+  }
+  layouts[index] = std::move(layout);
+  states[index]  = State::Flat;
+  return &layouts[index];
+}
+
+bool LayoutTable::flatten(const meta::di::StructureType& structure, size_t offset, member_path& path, Layout& out) {
+  // Same order as StructureType::find_member, direct members first.
+  for (const auto& member : structure.get_direct_members()) {
+    const auto size_in_bits = member.get_type().get_size_in_bits();
+    if (size_in_bits == 0) {
+      continue;
+    }
+    if (member.get_offset_in_bits() % 8 != 0 || size_in_bits % 8 != 0) {
+      // Bit fields
+      return false;
+    }
+    path.push_back(&member);
+    const bool success = add(member.get_type(), offset + member.get_offset_in_bits() / 8, path, out);
+    path.pop_back();
+    if (!success) {
+      return false;
+    }
+  }
+  for (const auto& inheritance : structure.get_base_classes()) {
+    if (inheritance.get_offset_in_bits() % 8 != 0 ||
+        !flatten(inheritance.get_base_structure_type(), offset + inheritance.get_offset_in_bits() / 8, path, out)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LayoutTable::add(const meta::di::Type& type, size_t offset, member_path& path, Layout& out) {
+  const auto make_entry = [&](const meta::di::Type& leaf, size_t stride, size_t count, meta::meta_id_t nested) {
+    Entry entry;
+    entry.offset     = offset;
+    entry.stride     = stride;
+    entry.count      = count;
+    entry.type       = &leaf;
+    entry.nested     = nested;
+    entry.path_begin = static_cast<std::uint32_t>(out.paths.size());
+    out.paths.insert(out.paths.end(), path.begin(), path.end());
+    entry.path_end = static_cast<std::uint32_t>(out.paths.size());
+    out.entries.push_back(entry);
+  };
+
+  const auto& canonical_type = type.strip_typedefs_and_qualifiers();
+  switch (canonical_type.get_kind()) {
+    case meta::Kind::StructureType:
+      return flatten(static_cast<const meta::di::StructureType&>(canonical_type), offset, path, out);
+    case meta::Kind::ArrayType: {
+      const auto& array_type   = static_cast<const meta::di::ArrayType&>(canonical_type);
+      const auto& element_type = array_type.get_base_type().strip_typedefs_and_qualifiers();
+      const auto count         = array_type.get_flattened_count();
+      const auto stride        = element_type.get_size_in_bits() / 8;
+      if (count == 0 || stride == 0) {
+        return true;
+      }
+      if (const auto* element_structure = meta::dyn_cast<meta::di::StructureType>(&element_type)) {
+        if (count == 1) {
+          return flatten(*element_structure, offset, path, out);
+        }
+        if (layout_for(*element_structure) == nullptr) {
+          return false;
+        }
+        make_entry(element_type, stride, count, element_structure->get_id());
+        return true;
+      }
+      if (element_type.is_union_type() || element_type.is_array_type()) {
+        return false;
+      }
+      make_entry(element_type, stride, count, meta::meta_id_t::invalid);
+      return true;
+    }
+    case meta::Kind::UnionType:
+      return false;
+    default:
+      make_entry(canonical_type, canonical_type.get_size_in_bits() / 8, 1, meta::meta_id_t::invalid);
+      return true;
+  }
+}
+
+const Layout* LayoutTable::find(const meta::di::StructureType& structure) const {
+  const auto index = index_for(structure);
+  if (index >= states.size() || states[index] != State::Flat) {
+    return nullptr;
+  }
+  return &layouts[index];
+}
+
+cpp::result<Resolved, Status> LayoutTable::resolve(const Layout& layout, size_t offset, member_path* path) const {
+  // Last entry beginning at or before offset
+  auto it = std::upper_bound(layout.entries.begin(), layout.entries.end(), offset,
+                             [](size_t value, const Entry& entry) { return value < entry.offset; });
+  if (it == layout.entries.begin()) {
+    return cpp::fail(Status::BAD_ALIGNMENT);
+  }
+  const auto& entry = *std::prev(it);
+  if (offset >= entry.end()) {
+    // Padding
+    return cpp::fail(Status::BAD_ALIGNMENT);
+  }
+
+  if (path != nullptr) {
+    path->insert(path->end(), layout.paths.begin() + entry.path_begin, layout.paths.begin() + entry.path_end);
+  }
+
+  const auto index           = (offset - entry.offset) / entry.stride;
+  const auto element_offset  = entry.offset + index * entry.stride;
+  const auto internal_offset = offset - element_offset;
+  if (entry.nested != meta::meta_id_t::invalid) {
+    const auto& nested_layout = layouts[static_cast<size_t>(entry.nested.value()) - 1];
+    auto nested_result        = resolve(nested_layout, internal_offset, path);
+    if (nested_result.has_error()) {
+      return nested_result;
+    }
+    auto nested = std::move(nested_result).value();
+    nested.offset += element_offset;
+    return nested;
+  }
+  if (internal_offset != 0) {
+    return cpp::fail(Status::BAD_ALIGNMENT);
+  }
+  return Resolved{entry.type, element_offset, entry.count - index, false};
+}
+
+cpp::result<Resolved, Status> LayoutTable::resolve(const meta::di::Type& type, size_t offset, member_path* path) const {
+  const auto& canonical_type = type.strip_typedefs_and_qualifiers();
+  switch (canonical_type.get_kind()) {
+    case meta::Kind::StructureType: {
+      const auto* layout = find(static_cast<const meta::di::StructureType&>(canonical_type));
+      if (layout == nullptr) {
+        return cpp::fail(Status::UNSUPPORTED_TYPE);
+      }
+      return resolve(*layout, offset, path);
+    }
+    case meta::Kind::ArrayType: {
+      const auto& array_type   = static_cast<const meta::di::ArrayType&>(canonical_type);
+      const auto& element_type = array_type.get_base_type().strip_typedefs_and_qualifiers();
+      const auto stride        = element_type.get_size_in_bits() / 8;
+      if (stride == 0) {
+        return cpp::fail(Status::UNSUPPORTED_TYPE);
+      }
+      const auto index          = offset / stride;
+      const auto element_offset = index * stride;
+      if (element_type.is_structure_type()) {
+        auto result = resolve(element_type, offset - element_offset, path);
+        if (result.has_value()) {
+          result.value().offset += element_offset;
+        }
+        return result;
+      }
+      if (element_type.is_union_type() || element_type.is_array_type()) {
+        return cpp::fail(Status::UNSUPPORTED_TYPE);
+      }
+      if (offset != element_offset) {
+        return cpp::fail(Status::BAD_ALIGNMENT);
+      }
+      return Resolved{&element_type, element_offset, array_type.get_flattened_count() - index, false};
+    }
+    case meta::Kind::UnionType:
+    case meta::Kind::VoidType:
+    case meta::Kind::SubroutineType:
+      return cpp::fail(Status::UNSUPPORTED_TYPE);
+    default:
+      if (offset != 0) {
+        return cpp::fail(Status::BAD_ALIGNMENT);
+      }
+      return Resolved{&canonical_type, 0, 1, true};
+  }
+}
+
+}  // namespace typeart::layout
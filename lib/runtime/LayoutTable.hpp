@@ -0,0 +1,93 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_LAYOUTTABLE_H
+#define TYPEART_LAYOUTTABLE_H
+
+#include "meta/Database.hpp"
+#include "runtime/Runtime.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace typeart::layout {
+
+// A run of count elements (of size stride) of a leaf type within a structure, i.e., a scalar member or the
+// elements of an array member. Nested structures are inlined, except for arrays of structures, these refer to
+// the layout of the element structure.
+struct Entry final {
+  // Offset of the first element w.r.t. the outermost structure, in bytes.
+  size_t offset{0};
+  size_t stride{0};
+  size_t count{0};
+  // The canonical leaf type, or the element type for arrays of structures.
+  const meta::di::Type* type{nullptr};
+  // Meta id of the element structure for arrays of structures, otherwise invalid.
+  meta::meta_id_t nested{meta::meta_id_t::invalid};
+  // The members accessed from the outermost structure to reach the entry, see Layout::paths.
+  std::uint32_t path_begin{0};
+  std::uint32_t path_end{0};
+
+  [[nodiscard]] inline size_t end() const {
+    return offset + stride * count;
+  }
+};
+
+// Flattened layout of a structure type, sorted by offset and free of overlaps.
+struct Layout final {
+  std::vector<Entry> entries;
+  // The member paths of all entries, stored contiguously.
+  std::vector<const meta::di::Member*> paths;
+};
+
+// Innermost (canonical) type at an offset within an element of some type.
+struct Resolved final {
+  const meta::di::Type* type{nullptr};
+  // Offset of the innermost element w.r.t. the queried type, in bytes.
+  size_t offset{0};
+  // Remaining element count of the innermost array (counting the element at offset), 1 for scalar members.
+  size_t count{0};
+  // True if the queried type itself is the innermost type, i.e., it is neither a structure nor an array.
+  bool is_whole{false};
+};
+
+// Flattened layouts of all structure types of the type database, built once at load.
+// A structure is not flattened if it contains unions or bit fields, or if members overlap.
+class LayoutTable final {
+  enum class State : std::uint8_t { None, Pending, Flat, Unsupported };
+
+  std::vector<State> states;
+  std::vector<Layout> layouts;
+
+  const Layout* layout_for(const meta::di::StructureType& structure);
+  bool flatten(const meta::di::StructureType& structure, size_t offset, member_path& path, Layout& out);
+  bool add(const meta::di::Type& type, size_t offset, member_path& path, Layout& out);
+
+  cpp::result<Resolved, Status> resolve(const Layout& layout, size_t offset, member_path* path) const;
+
+ public:
+  static LayoutTable build(const meta::Database& db);
+
+  // The flattened layout, or nullptr if the structure could not be flattened.
+  [[nodiscard]] const Layout* find(const meta::di::StructureType& structure) const;
+
+  // Resolves the innermost type at a byte offset within one element of type. If given, the members accessed to reach
+  // the innermost type are appended to path.
+  // Fails with Status::BAD_ALIGNMENT if offset does not point to the beginning of an innermost element (or points to
+  // padding), and with Status::UNSUPPORTED_TYPE if the layout of type is not flattened.
+  cpp::result<Resolved, Status> resolve(const meta::di::Type& type, size_t offset, member_path* path = nullptr) const;
+};
+
+}  // namespace typeart::layout
+
+#endif  // TYPEART_LAYOUTTABLE_H
@@ -0,0 +1,107 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "LookupCache.hpp"
+
+namespace typeart::lookup_cache {
+
+namespace {
+// Starts at 1 such that default constructed cache entries are never valid.
+std::atomic<Generation> generation{1};
+
+std::array<std::atomic<bool>, config::filter_size> filter{};
+// The generation bumped by the last invalidation per filter slot.
+std::array<std::atomic<Generation>, config::filter_size> invalidated{};
+
+inline size_t filter_index_for(const void* base_addr) {
+  const auto value = reinterpret_cast<uintptr_t>(base_addr);
+  return ((value >> 4U) ^ (value >> 16U)) & (config::filter_size - 1);
+}
+}  // namespace
+
+Generation current_generation() {
+  return generation.load(std::memory_order_acquire);
+}
+
+Generation mark_cached(const void* base_addr) {
+  auto& slot = filter[filter_index_for(base_addr)];
+  while (true) {
+    // Avoid writing to the (shared) cache line if the slot is already marked.
+    if (!slot.load(std::memory_order_relaxed)) {
+      slot.store(true);
+    }
+    const auto current = generation.load();
+    // An invalidation of a colliding allocation may have cleared the mark
+    // with its bump preceding the read. Later frees of base_addr would then
+    // not bump the generation, hence, mark again.
+    if (slot.load()) {
+      return current;
+    }
+  }
+}
+
+void invalidate(const void* base_addr) {
+  auto& slot = filter[filter_index_for(base_addr)];
+  // The slot is cleared before the generation is bumped: An insert either
+  // reads the bumped generation, or finds the slot still marked after reading
+  // the generation (see mark_cached), such that the next invalidation bumps.
+  if (slot.load(std::memory_order_relaxed) && slot.exchange(false)) {
+    const auto bumped = generation.fetch_add(1) + 1;
+    auto& last        = invalidated[filter_index_for(base_addr)];
+    auto previous     = last.load(std::memory_order_relaxed);
+    while (previous < bumped && !last.compare_exchange_weak(previous, bumped)) {
+    }
+  }
+}
+
+Generation invalidated_at(const void* base_addr) {
+  return invalidated[filter_index_for(base_addr)].load(std::memory_order_acquire);
+}
+
+LookupCache& LookupCache::get() {
+  static thread_local LookupCache cache;
+  return cache;
+}
+
+std::optional<cpp::result<PointerInfo, Status>> LookupCache::find(const void* addr, const void** base_addr,
+                                                                  Generation* generation) const {
+  const auto& entry = entries[index_for(addr)];
+  if (addr == nullptr || entry.addr != addr || entry.generation != current_generation()) {
+    return {};
+  }
+  if (base_addr != nullptr) {
+    *base_addr = entry.base_addr;
+  }
+  if (generation != nullptr) {
+    *generation = entry.generation;
+  }
+  if (entry.status != Status::OK) {
+    return cpp::result<PointerInfo, Status>{cpp::fail(entry.status)};
+  }
+  return cpp::result<PointerInfo, Status>{entry.info};
+}
+
+void LookupCache::insert(const void* addr, Generation generation, const cpp::result<PointerInfo, Status>& result,
+                         const void* base_addr) {
+  auto& entry      = entries[index_for(addr)];
+  entry.addr       = addr;
+  entry.generation = generation;
+  entry.base_addr  = base_addr;
+  if (result.has_value()) {
+    entry.status = Status::OK;
+    entry.info   = result.value();
+  } else {
+    entry.status = result.error();
+  }
+}
+
+}  // namespace typeart::lookup_cache
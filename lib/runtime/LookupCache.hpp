@@ -0,0 +1,97 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_LOOKUPCACHE_H
+#define TYPEART_LOOKUPCACHE_H
+
+#include "runtime/Runtime.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace typeart::lookup_cache {
+
+namespace config {
+// Number of entries of the per-thread cache, must be a power of two.
+constexpr size_t cache_size = 64;
+// Number of slots of the global filter that records which base addresses
+// have (possibly) been cached by any thread, must be a power of two.
+constexpr size_t filter_size = 4096;
+
+static_assert(__builtin_popcountll(cache_size) == 1);
+static_assert(__builtin_popcountll(filter_size) == 1);
+}  // namespace config
+
+// The generation is bumped whenever an allocation that may be cached by some
+// thread is freed, reallocated or overridden. All cache entries that were
+// recorded with an older generation are considered invalid.
+using Generation = std::uint64_t;
+
+Generation current_generation();
+
+// Marks the allocation beginning at base_addr as (possibly) cached and returns
+// the generation cache entries for it are valid for. The slot is still marked
+// after the generation was read, i.e., a later free of the allocation bumps the
+// generation even if an invalidation of a colliding allocation cleared the
+// slot concurrently.
+Generation mark_cached(const void* base_addr);
+
+// Must be called whenever the allocation beginning at base_addr is freed or
+// its meta data (type, count) changes.
+void invalidate(const void* base_addr);
+
+// Returns the generation of the last invalidation of an allocation whose base
+// address shares the filter slot with base_addr, or 0 if there was none.
+Generation invalidated_at(const void* base_addr);
+
+// A per-thread, direct-mapped cache of recent PointerInfo::get results.
+// Entries are keyed by the exact queried address, such that a hit neither
+// requires locking the allocation map nor resolving the subtype again.
+class LookupCache final {
+  struct Entry final {
+    const void* addr = nullptr;
+    Generation generation{0};
+    Status status{Status::OK};
+    PointerInfo info{};
+    // The base address of the containing allocation.
+    const void* base_addr = nullptr;
+  };
+
+  std::array<Entry, config::cache_size> entries{};
+
+  static inline size_t index_for(const void* addr) {
+    // The lower bits are mostly zero due to alignment.
+    const auto value = reinterpret_cast<uintptr_t>(addr);
+    return ((value >> 4U) ^ (value >> 12U)) & (config::cache_size - 1);
+  }
+
+ public:
+  static LookupCache& get();
+
+  // On a hit, the base address of the containing allocation is stored in base_addr and the generation of the entry
+  // in generation, if given.
+  std::optional<cpp::result<PointerInfo, Status>> find(const void* addr, const void** base_addr = nullptr,
+                                                       Generation* generation = nullptr) const;
+
+  // Inserts a result for addr. The generation must be the one returned by
+  // mark_cached for base_addr, and the result must be looked up again
+  // afterwards, otherwise a concurrent free may be missed.
+  void insert(const void* addr, Generation generation, const cpp::result<PointerInfo, Status>& result,
+              const void* base_addr);
+};
+
+}  // namespace typeart::lookup_cache
+
+#endif  // TYPEART_LOOKUPCACHE_H
@@ -16,15 +16,22 @@
 #include "runtime/AccessCountPrinter.h"
 #include "runtime/AccessCounter.hpp"
 #include "runtime/Internals.hpp"
+#include "runtime/LayoutTable.hpp"
+#include "runtime/LookupCache.hpp"
+#include "runtime/SubtypeCache.hpp"
+#include "runtime/TypeTable.hpp"
 #include "runtime/tracker/Tracker.hpp"
 #include "support/Logger.hpp"
 #include "support/System.hpp"
 
 #if defined(TYPEART_USE_ALLOCATOR) || defined(TYPEART_USE_HYBRID)
 #include "allocator/Allocator.hpp"
+#include "allocator/FastPath.hpp"
 #endif
 
+#include <algorithm>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <set>
 #include <sstream>
@@ -89,6 +96,12 @@ class Runtime {
 
   Initializer init;
   meta::Database db{};
+  layout::LayoutTable layouts{};
+  types::TypeTable types{};
+#if defined(TYPEART_USE_ALLOCATOR) || defined(TYPEART_USE_HYBRID)
+  std::vector<allocator::fast::AllocationEntry> allocation_entries{};
+  allocator::fast::AllocationTable allocation_table{};
+#endif
   Recorder recorder{};
 
  public:
@@ -110,6 +123,14 @@ class Runtime {
     return Runtime::get().db;
   }
 
+  static const layout::LayoutTable& getLayoutTable() {
+    return Runtime::get().layouts;
+  }
+
+  static const types::TypeTable& getTypeTable() {
+    return Runtime::get().types;
+  }
+
  public:
   Runtime() : init() {
     LOG_TRACE("TypeART Runtime Trace");
@@ -149,11 +170,29 @@ class Runtime {
       }
     }
 
+    types   = types::TypeTable::build(db);
+    layouts = layout::LayoutTable::build(db);
+
+#if defined(TYPEART_USE_ALLOCATOR) || defined(TYPEART_USE_HYBRID)
+    const auto& metas = db.getMeta();
+    allocation_entries.resize(metas.size());
+    for (size_t i = 0; i < metas.size(); ++i) {
+      if (const auto* allocation = meta::dyn_cast<meta::Allocation>(metas[i].get()); allocation != nullptr) {
+        allocation_entries[i] = {allocation, &allocation->get_type()};
+      }
+    }
+    allocation_table = {allocation_entries.data(), allocation_entries.size()};
+    allocator::fast::allocation_table.store(&allocation_table, std::memory_order_release);
+#endif
+
     init.reset();
   }
 
   ~Runtime() {
     scope = 1;
+#if defined(TYPEART_USE_ALLOCATOR) || defined(TYPEART_USE_HYBRID)
+    allocator::fast::allocation_table.store(nullptr, std::memory_order_release);
+#endif
     std::ostringstream stream;
     softcounter::serialize(recorder, stream);
     if (!stream.str().empty()) {
@@ -171,31 +210,199 @@ PointerInfo::PointerInfo(pointer base_addr, const meta::Allocation& allocation,
 }
 
 cpp::result<PointerInfo, Status> PointerInfo::get(pointer addr) {
-  auto guard = ScopeGuard{};
-  getRecorder().incUsedInRequest(addr);
 #ifdef TYPEART_USE_ALLOCATOR
-  auto pointer_info_opt = allocator::getPointerInfo(addr);
+  // Exact base addresses of heap allocations, only taken without softcounters to keep the counts exact.
+  if constexpr (std::is_same_v<Recorder, softcounter::NoneRecorder>) {
+    if (auto pointer_info = allocator::fast::heap_base_pointer_info(addr.get()); pointer_info.has_value()) {
+      return std::move(pointer_info).value();
+    }
+  }
+#endif
+  auto allocation_base = pointer{nullptr};
+  return get(addr, allocation_base);
+}
+
+namespace {
+
+std::optional<PointerInfo> find_allocation(pointer addr) {
+#ifdef TYPEART_USE_ALLOCATOR
+  return allocator::getPointerInfo(addr);
 #elifdef TYPEART_USE_TRACKER
-  auto pointer_info_opt = tracker::Tracker::get().getPointerInfo(addr);
+  return tracker::Tracker::get().getPointerInfo(addr);
 #else
   auto pointer_info_opt = allocator::getPointerInfo(addr);
   if (!pointer_info_opt.has_value()) {
     pointer_info_opt = tracker::Tracker::get().getPointerInfo(addr);
   }
+  return pointer_info_opt;
+#endif
+}
+
+// Appends the members at offset 0 of nested structures, i.e., the members PointerInfo::resolveToInnermostType passes.
+void append_first_members(const meta::di::Type& type, member_path& path) {
+  const auto* current = &type;
+  while (true) {
+    if (const auto* structure_type = meta::dyn_cast<meta::di::StructureType>(current)) {
+      const auto* first_member = structure_type->find_member(0);
+      if (first_member == nullptr) {
+        return;
+      }
+      path.push_back(first_member);
+      current = &first_member->get_type().strip_typedefs_and_qualifiers();
+    } else if (const auto* array_type = meta::dyn_cast<meta::di::ArrayType>(current)) {
+      current = &array_type->get_base_type().strip_typedefs_and_qualifiers();
+    } else {
+      return;
+    }
+  }
+}
+
+// Returns the generation a lookup cache entry for the allocation found for addr is valid for. Frees of unmarked
+// allocations do not bump the generation, hence, the generation is the one mark_cached read while the allocation was
+// marked. A free between the lookup and marking the allocation is detected by looking it up again, pointer_info is
+// updated to the repeated lookup. Returns 0 (never valid) if the allocation changed in the meantime.
+lookup_cache::Generation revalidate(pointer addr, PointerInfo& pointer_info) {
+#if defined(TYPEART_USE_ALLOCATOR) || defined(TYPEART_USE_HYBRID)
+  // Not cached, see PointerInfo::resolveFound.
+  if (allocator::stack::is_instrumented(const_cast<void*>(pointer_info.getBaseAddr().get()))) {
+    return 0;
+  }
 #endif
+  const auto generation = lookup_cache::mark_cached(pointer_info.getBaseAddr().get());
+  auto repeated         = find_allocation(addr);
+  if (!repeated.has_value() || repeated->getBaseAddr().get() != pointer_info.getBaseAddr().get()) {
+    return 0;
+  }
+  pointer_info = std::move(repeated).value();
+  return generation;
+}
+
+}  // namespace
+
+cpp::result<PointerInfo, Status> PointerInfo::get(pointer addr, pointer& allocation_base) {
+  std::uint64_t generation{0};
+  return lookup(addr, allocation_base, generation);
+}
+
+cpp::result<PointerInfo, Status> PointerInfo::get_with_generation(pointer addr, std::uint64_t& generation,
+                                                                  pointer& allocation_base) {
+  auto result = lookup(addr, allocation_base, generation);
+  if (result.has_error()) {
+    generation = 0;
+  }
+  return result;
+}
+
+cpp::result<PointerInfo, Status> PointerInfo::lookup(pointer addr, pointer& allocation_base,
+                                                     std::uint64_t& generation) {
+  auto guard     = ScopeGuard{};
+  auto& recorder = getRecorder();
+  recorder.incUsedInRequest(addr);
+
+  auto& cache = lookup_cache::LookupCache::get();
+  const void* cached_base = nullptr;
+  if (auto cached = cache.find(addr, &cached_base, &generation); cached.has_value()) {
+    recorder.incLookupCacheHit();
+    allocation_base = pointer{cached_base};
+    return std::move(cached).value();
+  }
+  recorder.incLookupCacheMiss();
+
+  auto pointer_info_opt = find_allocation(addr);
   if (!pointer_info_opt.has_value()) {
-    getRecorder().incAddrMissing(addr);
+    recorder.incAddrMissing(addr);
+    generation = 0;
     return cpp::fail(Status::UNKNOWN_ADDRESS);
   }
-  const auto pointer_info = std::move(pointer_info_opt).value();
-  if (addr == pointer_info.base_addr) {
-    return pointer_info;
+  // The same generation as the one of the lookup cache entry.
+  generation      = revalidate(addr, pointer_info_opt.value());
+  allocation_base = pointer_info_opt->base_addr;
+  return resolveFound(addr, pointer_info_opt.value(), generation);
+}
+
+std::uint64_t PointerInfo::current_generation() {
+  return lookup_cache::current_generation();
+}
+
+bool PointerInfo::is_unchanged_since(pointer allocation_base, std::uint64_t generation) {
+  if (generation == 0) {
+    return false;
+  }
+  return generation == lookup_cache::current_generation() ||
+         lookup_cache::invalidated_at(allocation_base.get()) <= generation;
+}
+
+void PointerInfo::get_batch(const void* const* addrs, size_t n, cpp::result<PointerInfo, Status>* results,
+                            const void** allocation_bases) {
+  auto guard     = ScopeGuard{};
+  auto& recorder = getRecorder();
+
+  auto& cache = lookup_cache::LookupCache::get();
+  std::vector<size_t> misses;
+  misses.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const auto addr = pointer{addrs[i]};
+    recorder.incUsedInRequest(addr);
+    if (auto cached = cache.find(addr, allocation_bases != nullptr ? &allocation_bases[i] : nullptr);
+        cached.has_value()) {
+      recorder.incLookupCacheHit();
+      results[i] = std::move(cached).value();
+    } else {
+      recorder.incLookupCacheMiss();
+      misses.push_back(i);
+    }
+  }
+  if (misses.empty()) {
+    return;
+  }
+
+  std::sort(misses.begin(), misses.end(), [addrs](size_t lhs, size_t rhs) {
+    return std::less<const void*>{}(addrs[lhs], addrs[rhs]);
+  });
+  std::vector<const void*> sorted_addrs(misses.size());
+  std::transform(misses.begin(), misses.end(), sorted_addrs.begin(), [addrs](size_t index) { return addrs[index]; });
+  std::vector<std::optional<PointerInfo>> pointer_infos(misses.size());
+
+#if defined(TYPEART_USE_ALLOCATOR) || defined(TYPEART_USE_HYBRID)
+  for (size_t i = 0; i < sorted_addrs.size(); ++i) {
+    pointer_infos[i] = allocator::getPointerInfo(pointer{sorted_addrs[i]});
+  }
+#endif
+#ifndef TYPEART_USE_ALLOCATOR
+  tracker::Tracker::get().getPointerInfoBatch(sorted_addrs.data(), sorted_addrs.size(), pointer_infos.data());
+#endif
+
+  for (size_t i = 0; i < misses.size(); ++i) {
+    const auto addr = pointer{sorted_addrs[i]};
+    if (!pointer_infos[i].has_value()) {
+      recorder.incAddrMissing(addr);
+      results[misses[i]] = cpp::fail(Status::UNKNOWN_ADDRESS);
+      continue;
+    }
+    const auto generation = revalidate(addr, pointer_infos[i].value());
+    if (allocation_bases != nullptr) {
+      allocation_bases[misses[i]] = pointer_infos[i]->base_addr.get();
+    }
+    results[misses[i]] = resolveFound(addr, pointer_infos[i].value(), generation);
+  }
+}
+
+cpp::result<PointerInfo, Status> PointerInfo::resolveFound(pointer addr, const PointerInfo& pointer_info,
+                                                           std::uint64_t generation) {
+  // Resolves to pointer_info itself for an exact match of the base address.
+  auto result = pointer_info.resolveSubtype(addr);
+#if defined(TYPEART_USE_ALLOCATOR) || defined(TYPEART_USE_HYBRID)
+  // Frames of the allocator stack are reused without any callback, hence such entries could never be invalidated.
+  if (allocator::stack::is_instrumented(const_cast<void*>(pointer_info.base_addr.get()))) {
+    return result;
   }
-  return pointer_info.resolveSubtype(addr);
+#endif
+  lookup_cache::LookupCache::get().insert(addr, generation, result, pointer_info.base_addr);
+  return result;
 }
 
 bool PointerInfo::contains(pointer p) const {
-  return base_addr <= p && p < (base_addr + byte_size::from_bits(count * type->get_size_in_bits()));
+  return base_addr <= p && p < (base_addr + byte_size::from_bytes(count * getTypeTable().size_of(*type)));
 }
 
 // Returns this pointer info with it's type canonicalized.
@@ -247,6 +454,50 @@ cpp::result<PointerInfo, Status> PointerInfo::findMember(byte_offset offset) con
   return StructMemberInfo::get(*this, offset).map([this](auto& value) { return value.intoPointerInfo(*this).value(); });
 }
 
+cpp::result<PointerInfo, Status> PointerInfo::resolveOffsetFast(pointer addr) const {
+  return resolveOffset(addr, nullptr);
+}
+
+cpp::result<PointerInfo, Status> PointerInfo::resolveOffsetFast(pointer addr, member_path& path) const {
+  return resolveOffset(addr, &path);
+}
+
+cpp::result<PointerInfo, Status> PointerInfo::resolveOffset(pointer addr, member_path* path) const {
+  auto subrange_result = getSubrange(addr);
+  if (subrange_result.has_error()) {
+    return cpp::fail(subrange_result.error());
+  }
+  const auto subrange = std::move(subrange_result).value();
+  auto resolved       = getLayoutTable().resolve(*type, static_cast<size_t>(subrange.offset.value()), path);
+  if (resolved.has_error()) {
+    if (resolved.error() != Status::UNSUPPORTED_TYPE) {
+      return cpp::fail(resolved.error());
+    }
+    // Layout is not flattened (e.g., unions or bit fields)
+    if (path == nullptr) {
+      return resolveSubtype(addr).map([](const PointerInfo& info) { return info.resolveToInnermostType(); });
+    }
+    // Not memoized, the memo only keeps a bounded prefix of the member path (see SubtypeCache).
+    return resolveSubtypeUncached(addr, path).map([path](const PointerInfo& info) {
+      append_first_members(info.getType(), *path);
+      return info.resolveToInnermostType();
+    });
+  }
+  const auto& innermost = resolved.value();
+  if (innermost.is_whole) {
+    return PointerInfo{subrange.base_addr, *allocation, *innermost.type, subrange.count};
+  }
+  const auto innermost_addr = subrange.base_addr + byte_offset::from_bytes(innermost.offset);
+  return PointerInfo{innermost_addr, *allocation, *innermost.type, innermost.count};
+}
+
+cpp::result<PointerInfo, Status> PointerInfo::resolveAddr(pointer addr) const {
+  if (!contains(addr)) {
+    return cpp::fail(Status::UNKNOWN_ADDRESS);
+  }
+  return resolveSubtype(addr);
+}
+
 cpp::result<PointerInfo::Subrange, Status> PointerInfo::getSubrange(pointer addr) const {
   // Check for exact match -> no further checks and offsets calculations needed
   if (base_addr == addr) {
@@ -254,7 +505,7 @@ cpp::result<PointerInfo::Subrange, Status> PointerInfo::getSubrange(pointer addr
   }
 
   // Ensure that the given address is in bounds
-  const auto type_size = byte_size::from_bits(type->get_size_in_bits());
+  const auto type_size = byte_size::from_bytes(getTypeTable().size_of(*type));
   if (!contains(addr)) {
     LOG_WARNING("Lookup for addr {} with pointer info {} was {} elements out of bounds!", addr, *this,
                 ((addr - base_addr).value() / type_size.value()) - count + 1);
@@ -284,6 +535,119 @@ cpp::result<PointerInfo, Status> PointerInfo::resolveSubtype(pointer addr) const
   if (subrange.offset == byte_offset::zero) {
     return PointerInfo{subrange.base_addr, *allocation, *type, subrange.count};
   }
+
+  // The resolution within an element only depends on the (canonical) type and the offset within the element.
+  const auto& table        = getTypeTable();
+  const auto type_index    = types::TypeTable::index_of(*type);
+  const auto type_id       = table.contains(type_index)
+                                 ? meta::meta_id_t{static_cast<meta_id_value>(table.record(type_index).canonical + 1)}
+                                 : type->strip_typedefs_and_qualifiers().get_id();
+  const auto offset_key    = static_cast<size_t>(subrange.offset.value());
+  auto& memo               = subtype_cache::SubtypeCache::get();
+  auto& recorder           = getRecorder();
+  const auto from_resolved = [&](const subtype_cache::Resolution& resolved) -> cpp::result<PointerInfo, Status> {
+    if (resolved.status != Status::OK) {
+      return cpp::fail(resolved.status);
+    }
+    return PointerInfo{subrange.base_addr + byte_offset::from_bytes(resolved.offset), *allocation, *resolved.type,
+                       resolved.count};
+  };
+  if (auto cached = memo.find(type_id, offset_key); cached.has_value()) {
+    recorder.incSubtypeMemoHit();
+    return from_resolved(cached.value());
+  }
+  recorder.incSubtypeMemoMiss();
+
+  subtype_cache::Resolution resolved;
+  member_path path;
+  auto result = resolveSubtypeUncached(addr, &path);
+  for (const auto* member : path) {
+    resolved.path.push(member);
+  }
+  if (result.has_value()) {
+    const auto& info = result.value();
+    resolved.type    = info.type;
+    resolved.offset  = static_cast<size_t>((info.base_addr - subrange.base_addr).value());
+    resolved.count   = info.count;
+  } else {
+    resolved.status = result.error();
+  }
+  switch (resolved.status) {
+    case Status::OK:
+    case Status::BAD_ALIGNMENT:
+    case Status::BAD_OFFSET:
+    case Status::UNSUPPORTED_TYPE:
+      memo.insert(type_id, offset_key, resolved);
+      break;
+    default:
+      break;
+  }
+  return result;
+}
+
+cpp::result<PointerInfo, Status> PointerInfo::resolveSubtypeUncached(pointer addr, member_path* path) const {
+  auto subrange_result = getSubrange(addr);
+  if (subrange_result.has_error()) {
+    return cpp::fail(subrange_result.error());
+  }
+  const auto subrange = std::move(subrange_result).value();
+  if (subrange.offset == byte_offset::zero) {
+    return PointerInfo{subrange.base_addr, *allocation, *type, subrange.count};
+  }
+
+  const auto& table = getTypeTable();
+  if (auto index = types::TypeTable::index_of(*type); table.contains(index)) {
+    auto element_addr  = subrange.base_addr;
+    auto offset        = static_cast<std::uint64_t>(subrange.offset.value());
+    auto element_count = subrange.count;
+    while (offset != 0) {
+      const auto canonical = table.record(index).canonical;
+      const auto& record   = table.record(canonical);
+      switch (record.kind) {
+        case meta::Kind::StructureType: {
+          std::uint64_t member_offset{0};
+          const auto* member = table.find_member(canonical, offset, member_offset);
+          if (member == nullptr) {
+            // A pointer to padding bytes within the struct is a pointer with a bad alignment to the struct
+            return cpp::fail(Status::BAD_ALIGNMENT);
+          }
+          if (path != nullptr) {
+            path->push_back(&table.member(*member));
+          }
+          element_addr  = element_addr + byte_offset::from_bytes(static_cast<ssize_t>(member_offset));
+          offset        = offset - member_offset;
+          index         = member->type;
+          element_count = 1;
+          break;
+        }
+        case meta::Kind::ArrayType: {
+          const auto stride = table.record(record.element).size;
+          if (offset >= record.size || stride == 0) {
+            return cpp::fail(Status::BAD_OFFSET);
+          }
+          const auto element_index = offset / stride;
+          element_addr  = element_addr + byte_offset::from_bytes(static_cast<ssize_t>(element_index * stride));
+          offset        = offset % stride;
+          index         = record.element;
+          element_count = record.count - element_index;
+          break;
+        }
+        case meta::Kind::UnionType:
+          LOG_FATAL("Unions cannot currently be type-checked correctly!");
+          return cpp::fail(Status::UNSUPPORTED_TYPE);
+        case meta::Kind::SubroutineType:
+          LOG_FATAL("Unexpected SubroutineType while resolving address!");
+          return cpp::fail(Status::UNSUPPORTED_TYPE);
+        case meta::Kind::VoidType:
+          return cpp::fail(Status::UNSUPPORTED_TYPE);
+        default:
+          return cpp::fail(Status::BAD_ALIGNMENT);
+      }
+    }
+    return PointerInfo{element_addr, *allocation, table.type(index), element_count};
+  }
+
+  // Types which are not part of the type database
   const auto& canonical_type = type->strip_typedefs_and_qualifiers();
   assert(type != nullptr);
   return meta::di::visit_type(
@@ -309,7 +673,10 @@ cpp::result<PointerInfo, Status> PointerInfo::resolveSubtype(pointer addr) const
               }
             }
             const auto member_info = std::move(member_info_result.value());
-            return member_info.intoPointerInfo(*this).value().resolveSubtype(addr);
+            if (path != nullptr) {
+              path->push_back(member_info.member);
+            }
+            return member_info.intoPointerInfo(*this).value().resolveSubtypeUncached(addr, path);
           },
           [&](const meta::di::UnionType&) {
             LOG_FATAL("Unions cannot currently be type-checked correctly!");
@@ -321,7 +688,7 @@ cpp::result<PointerInfo, Status> PointerInfo::resolveSubtype(pointer addr) const
               return cpp::fail(array_info_result.error());
             }
             const auto array_info = std::move(array_info_result).value();
-            return array_info.intoPointerInfo(*this).value().resolveSubtype(addr);
+            return array_info.intoPointerInfo(*this).value().resolveSubtypeUncached(addr, path);
           },
           [](const meta::di::SubroutineType&) {
             LOG_FATAL("Unexpected SubroutineType while resolving address!");
@@ -350,8 +717,18 @@ cpp::result<StructMemberInfo, Status> StructMemberInfo::get(pointer base_addr, b
     return cpp::fail(Status::OFFSET_OUT_OF_RANGE);
   }
 
-  // Get index of the struct member at the address
-  const auto member = type.find_member(offset.as_bits());
+  // Get index of the struct member at the address. The member is the first one of the member path if the subtype at
+  // offset was memoized before (see PointerInfo::resolveSubtype), which saves walking the members.
+  const meta::di::Member* member{nullptr};
+  if (const auto offset_key = static_cast<size_t>(offset.value()); offset_key != 0) {
+    const auto resolved = subtype_cache::SubtypeCache::get().find(type.get_id(), offset_key);
+    if (resolved.has_value() && resolved->path.length != 0) {
+      member = resolved->path.members[0];
+    }
+  }
+  if (member == nullptr) {
+    member = type.find_member(offset.as_bits());
+  }
   if (member == nullptr) {
     return cpp::fail(Status::BAD_OFFSET);
   }
@@ -414,4 +791,12 @@ meta::Database& getDatabase() {
   return Runtime::getDatabase();
 }
 
+const layout::LayoutTable& getLayoutTable() {
+  return Runtime::getLayoutTable();
+}
+
+const types::TypeTable& getTypeTable() {
+  return Runtime::getTypeTable();
+}
+
 }  // namespace typeart
@@ -0,0 +1,69 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "runtime/RuntimeInterface.h"
+
+#include "runtime/Internals.hpp"
+#include "runtime/Runtime.hpp"
+#include "runtime/TypeTable.hpp"
+
+#include <vector>
+
+namespace typeart {
+namespace {
+static_assert(static_cast<int>(Status::OK) == TYPEART_OK);
+static_assert(static_cast<int>(Status::UNSUPPORTED_TYPE) == TYPEART_UNSUPPORTED_TYPE);
+
+inline typeart_status to_status(Status status) {
+  return static_cast<typeart_status>(status);
+}
+
+inline void to_type_info(const void* addr, const void* allocation_base, const PointerInfo& info,
+                         typeart_type_info& out) {
+  out.base_addr    = allocation_base;
+  out.offset       = static_cast<size_t>(static_cast<const char*>(addr) - static_cast<const char*>(allocation_base));
+  out.type_id      = info.getType().get_id().value();
+  out.count        = info.getCount();
+  out.element_size = getTypeTable().size_of(info.getType());
+}
+}  // namespace
+}  // namespace typeart
+
+extern "C" {
+
+typeart_status typeart_get_type(const void* addr, typeart_type_info* info) {
+  using namespace typeart;
+  auto allocation_base = pointer{nullptr};
+  const auto result    = PointerInfo::get(pointer{addr}, allocation_base);
+  if (result.has_error()) {
+    return to_status(result.error());
+  }
+  to_type_info(addr, allocation_base.get(), result.value(), *info);
+  return TYPEART_OK;
+}
+
+void typeart_get_types(const void* const* addrs, size_t n, typeart_type_info* infos, typeart_status* statuses) {
+  using namespace typeart;
+  std::vector<cpp::result<PointerInfo, Status>> results(n);
+  std::vector<const void*> allocation_bases(n, nullptr);
+  PointerInfo::get_batch(addrs, n, results.data(), allocation_bases.data());
+  for (size_t i = 0; i < n; ++i) {
+    if (results[i].has_error()) {
+      statuses[i] = to_status(results[i].error());
+      continue;
+    }
+    statuses[i] = TYPEART_OK;
+    to_type_info(addrs[i], allocation_bases[i], results[i].value(), infos[i]);
+  }
+}
+
+}  // extern "C"
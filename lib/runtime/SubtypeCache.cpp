@@ -0,0 +1,44 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "SubtypeCache.hpp"
+
+namespace typeart::subtype_cache {
+
+SubtypeCache& SubtypeCache::get() {
+  static SubtypeCache cache;
+  return cache;
+}
+
+std::optional<Resolution> SubtypeCache::find(meta::meta_id_t type_id, size_t offset) {
+  const auto key = hash(type_id, offset);
+  auto& shard    = shards[key & (config::shard_count - 1)];
+  // Lookups (the common case once the memo is warm) do not exclude each other.
+  std::shared_lock<std::shared_mutex> guard(shard.mutex);
+  const auto& entry = shard.entries[(key / config::shard_count) & (config::shard_size - 1)];
+  if (entry.type_id != type_id || entry.offset != offset) {
+    return {};
+  }
+  return entry.resolution;
+}
+
+void SubtypeCache::insert(meta::meta_id_t type_id, size_t offset, const Resolution& resolution) {
+  const auto key = hash(type_id, offset);
+  auto& shard    = shards[key & (config::shard_count - 1)];
+  std::unique_lock<std::shared_mutex> guard(shard.mutex);
+  auto& entry      = shard.entries[(key / config::shard_count) & (config::shard_size - 1)];
+  entry.type_id    = type_id;
+  entry.offset     = offset;
+  entry.resolution = resolution;
+}
+
+}  // namespace typeart::subtype_cache
@@ -0,0 +1,95 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_SUBTYPECACHE_H
+#define TYPEART_SUBTYPECACHE_H
+
+#include "runtime/Runtime.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <shared_mutex>
+
+namespace typeart::subtype_cache {
+
+namespace config {
+// Number of shards (each with its own reader/writer lock) and entries per shard, must be powers of two.
+constexpr size_t shard_count = 16;
+constexpr size_t shard_size  = 256;
+// Maximum number of members recorded per resolution, deeper paths are truncated.
+constexpr size_t max_path_length = 8;
+
+static_assert(__builtin_popcountll(shard_count) == 1);
+static_assert(__builtin_popcountll(shard_size) == 1);
+}  // namespace config
+
+// The members accessed (outermost first) to reach the resolved subtype.
+struct MemberPath final {
+  std::array<const meta::di::Member*, config::max_path_length> members{};
+  std::uint8_t length{0};
+  bool truncated{false};
+
+  inline void push(const meta::di::Member* member) {
+    if (length == config::max_path_length) {
+      truncated = true;
+      return;
+    }
+    members[length++] = member;
+  }
+};
+
+// Result of resolving the subtype at a (non-zero) offset within an element of a canonical type. Only depends on
+// the type and the offset, not on the allocation.
+struct Resolution final {
+  Status status{Status::OK};
+  const meta::di::Type* type{nullptr};
+  // Offset of the subtype w.r.t. the element, in bytes.
+  size_t offset{0};
+  size_t count{0};
+  // For structure types, the first member contains the offset (see StructMemberInfo::get), empty for padding.
+  MemberPath path{};
+};
+
+// A concurrent, bounded (direct-mapped) memo of subtype resolutions, keyed by the canonical type and the offset
+// within one of its elements. Type meta data is immutable after load, entries are never invalidated.
+class SubtypeCache final {
+  struct Entry final {
+    meta::meta_id_t type_id{meta::meta_id_t::invalid};
+    size_t offset{0};
+    Resolution resolution{};
+  };
+
+  struct Shard final {
+    std::shared_mutex mutex;
+    std::array<Entry, config::shard_size> entries{};
+  };
+
+  std::array<Shard, config::shard_count> shards{};
+
+  static inline size_t hash(meta::meta_id_t type_id, size_t offset) {
+    const auto value = (static_cast<size_t>(type_id.value()) * 0x9E3779B97F4A7C15ULL) ^ offset;
+    return value ^ (value >> 29U);
+  }
+
+ public:
+  static SubtypeCache& get();
+
+  std::optional<Resolution> find(meta::meta_id_t type_id, size_t offset);
+
+  void insert(meta::meta_id_t type_id, size_t offset, const Resolution& resolution);
+};
+
+}  // namespace typeart::subtype_cache
+
+#endif  // TYPEART_SUBTYPECACHE_H
@@ -0,0 +1,102 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "TypeTable.hpp"
+
+#include "support/Logger.hpp"
+
+namespace typeart::types {
+
+TypeTable TypeTable::build(const meta::Database& db) {
+  TypeTable table;
+  const auto& all_metas = db.getMeta();
+  table.types.resize(all_metas.size());
+  table.metas.reserve(all_metas.size());
+  for (const auto& meta : all_metas) {
+    table.metas.push_back(meta.get());
+  }
+
+  size_t type_count{0};
+  for (const auto& meta : all_metas) {
+    const auto* type = meta::dyn_cast<meta::di::Type>(meta.get());
+    if (type == nullptr) {
+      continue;
+    }
+    const auto index = index_of(*type);
+    if (index >= table.types.size()) {
+      continue;
+    }
+    auto& record     = table.types[index];
+    record.kind      = type->get_kind();
+    record.size      = type->get_size_in_bits() / 8;
+    record.canonical = index_of(type->strip_typedefs_and_qualifiers());
+    ++type_count;
+
+    if (const auto* array_type = meta::dyn_cast<meta::di::ArrayType>(type)) {
+      record.element = index_of(array_type->get_base_type());
+      record.count   = array_type->get_flattened_count();
+    } else if (const auto* structure_type = meta::dyn_cast<meta::di::StructureType>(type)) {
+      // Same order as StructureType::find_member, direct members first.
+      record.members_begin = static_cast<index_t>(table.members.size());
+      for (const auto& member : structure_type->get_direct_members()) {
+        MemberRecord member_record;
+        member_record.offset = member.get_offset_in_bits() / 8;
+        member_record.size   = member.get_type().get_size_in_bits() / 8;
+        member_record.type   = index_of(member.get_type());
+        member_record.member = index_of(member);
+        table.members.push_back(member_record);
+      }
+      record.members_end = static_cast<index_t>(table.members.size());
+
+      record.bases_begin = static_cast<index_t>(table.bases.size());
+      for (const auto& inheritance : structure_type->get_base_classes()) {
+        BaseRecord base_record;
+        base_record.offset    = inheritance.get_offset_in_bits() / 8;
+        base_record.structure = index_of(inheritance.get_base_structure_type());
+        table.bases.push_back(base_record);
+      }
+      record.bases_end = static_cast<index_t>(table.bases.size());
+    }
+  }
+  LOG_DEBUG("Type table with {} types, {} members and {} base classes", type_count, table.members.size(),
+            table.bases.size());
+  return table;
+}
+
+const MemberRecord* TypeTable::find_member(index_t structure, std::uint64_t offset,
+                                           std::uint64_t& absolute_offset) const {
+  if (!contains(structure)) {
+    return nullptr;
+  }
+  const auto& record = types[structure];
+  for (auto index = record.members_begin; index < record.members_end; ++index) {
+    const auto& member = members[index];
+    if (member.offset <= offset && offset < member.offset + member.size) {
+      absolute_offset += member.offset;
+      return &member;
+    }
+  }
+  for (auto index = record.bases_begin; index < record.bases_end; ++index) {
+    const auto& base = bases[index];
+    if (offset < base.offset) {
+      continue;
+    }
+    auto base_offset = absolute_offset + base.offset;
+    if (const auto* member = find_member(base.structure, offset - base.offset, base_offset); member != nullptr) {
+      absolute_offset = base_offset;
+      return member;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace typeart::types
@@ -0,0 +1,108 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_TYPETABLE_H
+#define TYPEART_TYPETABLE_H
+
+#include "meta/Database.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace typeart::types {
+
+// Index of a meta into the table, i.e., its meta id - 1.
+using index_t = std::uint32_t;
+
+constexpr index_t npos = ~index_t{0};
+
+// Read-only record of a type. Kind::Unknown for metas which are not types.
+struct TypeRecord final {
+  std::uint64_t size{0};
+  // ArrayType: flattened element count
+  std::uint64_t count{0};
+  // The type with typedefs and qualifiers stripped, refers to itself for canonical types.
+  index_t canonical{npos};
+  // ArrayType: the (declared) element type
+  index_t element{npos};
+  // StructureType: direct members and base classes, see TypeTable::members and TypeTable::bases
+  index_t members_begin{0};
+  index_t members_end{0};
+  index_t bases_begin{0};
+  index_t bases_end{0};
+  meta::Kind kind{meta::Kind::Unknown};
+};
+
+struct MemberRecord final {
+  // Offset w.r.t. the structure declaring the member, in bytes.
+  std::uint64_t offset{0};
+  std::uint64_t size{0};
+  // The (declared) type of the member.
+  index_t type{npos};
+  // The di::Member itself.
+  index_t member{npos};
+};
+
+struct BaseRecord final {
+  std::uint64_t offset{0};
+  // The canonical base structure type.
+  index_t structure{npos};
+};
+
+// Compact representation of all types of the type database, built once at load: canonical types are resolved
+// upfront and type records are stored contiguously with fixed-width indices instead of pointers, so that queries
+// do not need any virtual calls.
+class TypeTable final {
+  std::vector<TypeRecord> types;
+  std::vector<MemberRecord> members;
+  std::vector<BaseRecord> bases;
+  std::vector<const meta::Meta*> metas;
+
+ public:
+  static TypeTable build(const meta::Database& db);
+
+  [[nodiscard]] inline bool contains(index_t index) const {
+    return index < types.size() && types[index].kind != meta::Kind::Unknown;
+  }
+
+  [[nodiscard]] inline static index_t index_of(const meta::Meta& meta) {
+    return static_cast<index_t>(meta.get_id().value()) - 1;
+  }
+
+  [[nodiscard]] inline const TypeRecord& record(index_t index) const {
+    return types[index];
+  }
+
+  [[nodiscard]] inline const meta::di::Type& type(index_t index) const {
+    return *static_cast<const meta::di::Type*>(metas[index]);
+  }
+
+  [[nodiscard]] inline const meta::di::Member& member(const MemberRecord& record) const {
+    return *static_cast<const meta::di::Member*>(metas[record.member]);
+  }
+
+  // Size of the type in bytes.
+  [[nodiscard]] inline std::uint64_t size_of(const meta::di::Type& type) const {
+    const auto index = index_of(type);
+    return contains(index) ? types[index].size : type.get_size_in_bits() / 8;
+  }
+
+  // Finds the (direct or inherited) member at offset within the structure and adds the offset of the member w.r.t.
+  // the structure to absolute_offset. Returns nullptr for padding.
+  [[nodiscard]] const MemberRecord* find_member(index_t structure, std::uint64_t offset,
+                                                std::uint64_t& absolute_offset) const;
+};
+
+}  // namespace typeart::types
+
+#endif  // TYPEART_TYPETABLE_H
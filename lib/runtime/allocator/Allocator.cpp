@@ -1,7 +1,9 @@
 #include "runtime/allocator/Allocator.hpp"
 
 #include "Config.h"
+#include "FastPath.hpp"
 #include "runtime/Internals.hpp"
+#include "runtime/LookupCache.hpp"
 #include "runtime/Runtime.hpp"
 #include "runtime/tracker/Tracker.hpp"
 
@@ -128,11 +130,15 @@ __attribute__((constructor)) void ctor() {
     auto region_begin = (int8_t*)regions_ptr + i * region_size;
     regions[i].initialize(region_begin, region_begin + region_size, min_allocation_size << i);
   }
-  initialized = true;
+  fast::heap_begin = regions_ptr;
+  fast::heap_end   = (int8_t*)regions_ptr + region_count * region_size;
+  initialized      = true;
 }
 
 __attribute__((destructor)) void dtor() {
-  initialized = false;
+  initialized      = false;
+  fast::heap_begin = nullptr;
+  fast::heap_end   = nullptr;
 }
 #endif
 
@@ -212,6 +218,7 @@ void* realloc(meta::meta_id_t meta_id, size_t count, void* ptr, size_t new_size)
   const auto old_allocation_size = old_region->allocation_size;
   const auto old_data_size       = old_allocation_size - heap::min_alignment;
   if (heap::is_instrumented(ptr) && required_size <= old_allocation_size) {
+    lookup_cache::invalidate(ptr);
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wcast-align"
     *(size_t*)((uint8_t*)ptr - sizeof(size_t)) = count;
@@ -231,6 +238,7 @@ bool free(void* addr) {
     return heap::is_instrumented(addr);
   }
   if (heap::is_instrumented(addr)) {
+    lookup_cache::invalidate(addr);
     heap::region_for(addr)->free(addr);
     return true;
   } else {
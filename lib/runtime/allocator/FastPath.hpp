@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Config.h"
+#include "runtime/Runtime.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace typeart::allocator::fast {
+
+struct AllocationEntry final {
+  const meta::Allocation* allocation{nullptr};
+  const meta::di::Type* type{nullptr};
+};
+
+// Allocation meta data indexed by meta id - 1, published once the type database is loaded.
+struct AllocationTable final {
+  const AllocationEntry* entries{nullptr};
+  size_t size{0};
+};
+
+inline std::atomic<const AllocationTable*> allocation_table{nullptr};
+
+// Bounds of the heap regions, set by the allocator at initialization.
+inline const void* heap_begin = nullptr;
+inline const void* heap_end   = nullptr;
+
+// Returns the pointer info of the heap allocation if addr is its exact base address.
+// Neither requires the runtime singleton nor the type database, any other address returns an empty optional and
+// needs to be looked up with allocator::getPointerInfo.
+inline std::optional<PointerInfo> heap_base_pointer_info(const void* addr) {
+  if (addr < heap_begin || addr >= heap_end) {
+    return {};
+  }
+  const auto* table = allocation_table.load(std::memory_order_acquire);
+  if (table == nullptr) {
+    return {};
+  }
+  const auto offset          = reinterpret_cast<uintptr_t>(addr) - reinterpret_cast<uintptr_t>(heap_begin);
+  const auto allocation_size = config::heap::min_allocation_size << (offset / config::heap::region_size);
+  const auto bucket          = reinterpret_cast<uintptr_t>(addr) & ~(allocation_size - 1);
+  if (reinterpret_cast<uintptr_t>(addr) != bucket + config::heap::min_alignment) {
+    return {};
+  }
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wcast-align"
+  const auto meta_id = reinterpret_cast<const meta::meta_id_t*>(bucket)->value();
+  const auto count   = *reinterpret_cast<const size_t*>(bucket + config::heap::count_offset);
+#pragma clang diagnostic pop
+  if (meta_id <= 0 || static_cast<size_t>(meta_id) > table->size) {
+    return {};
+  }
+  const auto& entry = table->entries[meta_id - 1];
+  if (entry.allocation == nullptr) {
+    return {};
+  }
+  return PointerInfo{pointer{addr}, *entry.allocation, *entry.type, count};
+}
+
+}  // namespace typeart::allocator::fast
@@ -22,7 +22,7 @@
 
 namespace typeart::tracker {
 namespace mixin {
-enum class BulkOperation { remove = 0 };
+enum class BulkOperation { remove = 0, insert };
 
 namespace detail {
 template <typename Map>
@@ -64,7 +64,7 @@ struct MapOp {
   template <typename PointerMap>
   [[nodiscard]] inline static bool put(PointerMap&& xlocked_map, const void* addr, const RuntimeT::MappedType& data) {
     auto& def             = (*xlocked_map)[addr];
-    const bool overridden = (def.getBaseAddr() != nullptr);
+    const bool overridden = def.isValid();
     def                   = data;
     return overridden;
   }
@@ -89,6 +89,35 @@ struct MapOp {
     return {*std::prev(it)};
   }
 
+  // Expects [s, e) to be sorted by address: The map is walked in order, i.e., the containing allocations of nearby
+  // addresses are found by advancing the previous position instead of a new search from the root.
+  template <typename PointerMap, typename FwdIter, typename Callback>
+  inline static void find_range(PointerMap&& slocked_map, FwdIter&& s, FwdIter&& e, Callback&& found) {
+    // Maximum number of map entries to step over before falling back to a regular search.
+    constexpr int max_steps = 8;
+    if (slocked_map->empty()) {
+      std::for_each(s, e, [&found](const void* addr) { found(addr, llvm::None); });
+      return;
+    }
+    auto it = slocked_map->begin();
+    std::for_each(s, e, [&](const void* addr) {
+      if (addr < slocked_map->begin()->first) {
+        found(addr, llvm::None);
+        return;
+      }
+      // Find the first entry beyond addr, its predecessor is the containing allocation.
+      int steps = 0;
+      while (it != slocked_map->end() && !(addr < it->first) && steps < max_steps) {
+        ++it;
+        ++steps;
+      }
+      if (steps == max_steps) {
+        it = slocked_map->upper_bound(addr);
+      }
+      found(addr, llvm::Optional<RuntimeT::MapEntry>{*std::prev(it)});
+    });
+  }
+
   template <typename PointerMap>
   [[nodiscard]] inline static llvm::Optional<RuntimeT::MappedType> remove(PointerMap&& xlocked_map, const void* addr) {
     const auto it = xlocked_map->find(addr);
@@ -107,6 +136,18 @@ struct MapOp {
         auto removed = remove(std::forward<PointerMap>(xlocked_map), addr);
         log(removed, addr);
       });
+    } else if constexpr (Operation == BulkOperation::insert) {
+      // Expects [s, e) to be sorted by address: Consecutive inserts then hit the same, already cached, tree nodes.
+      std::for_each(s, e, [&xlocked_map, &log](const auto& entry) {
+        auto it               = xlocked_map->lower_bound(entry.first);
+        const bool overridden = it != xlocked_map->end() && it->first == entry.first;
+        if (overridden) {
+          it->second = entry.second;
+        } else {
+          xlocked_map->emplace_hint(it, entry.first, entry.second);
+        }
+        log(overridden, entry.first);
+      });
     } else {
       static_assert(true, "Unsupported operation");
     }
@@ -127,11 +168,23 @@ struct StandardMapBase : protected BaseOp {
     return BaseOp::remove(detail::as_ptr(this->map()), addr);
   }
 
+  template <typename FwdIter, typename Callback>
+  inline void find_range(FwdIter&& s, FwdIter&& e, Callback&& found) const {
+    BaseOp::find_range(detail::as_ptr(this->map()), std::forward<FwdIter>(s), std::forward<FwdIter>(e),
+                       std::forward<Callback>(found));
+  }
+
   template <typename FwdIter, typename Callback>
   inline void remove_range(FwdIter&& s, FwdIter&& e, Callback&& log) {
     BaseOp::template bulk_op<BulkOperation::remove>(detail::as_ptr(this->map()), std::forward<FwdIter>(s),
                                                     std::forward<FwdIter>(e), std::forward<Callback>(log));
   }
+
+  template <typename FwdIter, typename Callback>
+  inline void put_range(FwdIter&& s, FwdIter&& e, Callback&& log) {
+    BaseOp::template bulk_op<BulkOperation::insert>(detail::as_ptr(this->map()), std::forward<FwdIter>(s),
+                                                    std::forward<FwdIter>(e), std::forward<Callback>(log));
+  }
 };
 
 template <typename BaseOp>
@@ -155,11 +208,23 @@ struct SharedMutexMap : public BaseOp {
     return BaseOp::remove(addr);
   }
 
+  template <typename FwdIter, typename Callback>
+  inline void find_range(FwdIter&& s, FwdIter&& e, Callback&& found) const {
+    std::shared_lock<std::shared_mutex> guard(alloc_m);
+    BaseOp::find_range(std::forward<FwdIter>(s), std::forward<FwdIter>(e), std::forward<Callback>(found));
+  }
+
   template <typename FwdIter, typename Callback>
   inline void remove_range(FwdIter&& s, FwdIter&& e, Callback&& log) {
     std::lock_guard<std::shared_mutex> guard(alloc_m);
     BaseOp::remove_range(std::forward<FwdIter>(s), std::forward<FwdIter>(e), std::forward<Callback>(log));
   }
+
+  template <typename FwdIter, typename Callback>
+  inline void put_range(FwdIter&& s, FwdIter&& e, Callback&& log) {
+    std::lock_guard<std::shared_mutex> guard(alloc_m);
+    BaseOp::put_range(std::forward<FwdIter>(s), std::forward<FwdIter>(e), std::forward<Callback>(log));
+  }
 };
 
 #ifdef USE_SAFEPTR
@@ -180,6 +245,13 @@ struct SafePtrdMap : protected BaseOp {
     return BaseOp::remove(guard, addr);
   }
 
+  template <typename FwdIter, typename Callback>
+  inline void find_range(FwdIter&& s, FwdIter&& e, Callback&& found) const {
+    auto slockedAllocs = sf::slock_safe_ptr(this->map());
+    BaseOp::find_range(slockedAllocs, std::forward<FwdIter>(s), std::forward<FwdIter>(e),
+                       std::forward<Callback>(found));
+  }
+
   template <typename FwdIter, typename Callback>
   inline void remove_range(FwdIter&& s, FwdIter&& e, Callback&& log) {
     using namespace detail;
@@ -187,6 +259,13 @@ struct SafePtrdMap : protected BaseOp {
     BaseOp::template bulk_op<BulkOperation::remove>(guard, std::forward<FwdIter>(s), std::forward<FwdIter>(e),
                                                     std::forward<Callback>(log));
   }
+
+  template <typename FwdIter, typename Callback>
+  inline void put_range(FwdIter&& s, FwdIter&& e, Callback&& log) {
+    auto guard = sf::xlock_safe_ptr(this->map());
+    BaseOp::template bulk_op<BulkOperation::insert>(guard, std::forward<FwdIter>(s), std::forward<FwdIter>(e),
+                                                    std::forward<Callback>(log));
+  }
 };
 #endif
 }  // namespace mixin
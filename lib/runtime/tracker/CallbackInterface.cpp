@@ -32,6 +32,13 @@ void typeart_tracker_alloc_global(const void* addr, meta::meta_id_t::value_type
   tracker::Tracker::get().onAllocGlobal(addr, meta_id, count, retAddr);
 }
 
+void typeart_tracker_alloc_bulk(const void** addrs, meta::meta_id_t::value_type meta_id, const size_t* counts,
+                                size_t n) {
+  TYPEART_RUNTIME_GUARD;
+  const void* retAddr = __builtin_return_address(0);
+  tracker::Tracker::get().onAllocBulk(addrs, meta::meta_id_t{meta_id}, counts, n, retAddr);
+}
+
 void typeart_tracker_free(const void* addr) {
   TYPEART_RUNTIME_GUARD;
   const void* retAddr = __builtin_return_address(0);
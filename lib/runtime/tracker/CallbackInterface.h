@@ -28,6 +28,8 @@ extern "C" {
 void typeart_tracker_alloc(const void* addr, meta_id_value meta_id, size_t count);
 void typeart_tracker_alloc_global(const void* addr, meta_id_value meta_id, size_t count);
 void typeart_tracker_free(const void* addr);
+// Registers n heap allocations of the same meta_id at once, e.g., allocated in a loop.
+void typeart_tracker_alloc_bulk(const void** addrs, meta_id_value meta_id, const size_t* counts, size_t n);
 
 void typeart_tracker_alloc_stack(const void* addr, meta_id_value meta_id, size_t count);
 void typeart_tracker_leave_scope(int alloca_count);
@@ -0,0 +1,171 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_FREEQUEUE_H
+#define TYPEART_FREEQUEUE_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace typeart::tracker {
+
+#ifdef TYPEART_DISABLE_THREAD_SAFETY
+struct NoneMutex final {
+  void lock() {
+  }
+  void unlock() {
+  }
+};
+using FreeQueueMutex = NoneMutex;
+#else
+using FreeQueueMutex = std::mutex;
+#endif
+
+// Ring buffer of heap addresses whose free was not yet applied to the allocation map.
+class FreeQueue final {
+ public:
+  static constexpr size_t capacity = 256;
+
+ private:
+  std::array<const void*, capacity> ring{};
+  size_t head{0};
+  size_t size{0};
+
+ public:
+  [[nodiscard]] inline bool empty() const {
+    return size == 0;
+  }
+
+  [[nodiscard]] inline bool full() const {
+    return size == capacity;
+  }
+
+  inline void push(const void* addr) {
+    assert(!full() && "Free queue must be drained first");
+    ring[(head + size) % capacity] = addr;
+    ++size;
+  }
+
+  // Removes one pending free of addr, the order of the remaining entries is not kept.
+  inline bool erase(const void* addr) {
+    for (size_t i = 0; i < size; ++i) {
+      auto& slot = ring[(head + i) % capacity];
+      if (slot == addr) {
+        slot = ring[head];
+        head = (head + 1) % capacity;
+        --size;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Moves all pending frees to out and empties the queue.
+  template <typename OutIter>
+  inline OutIter take(OutIter out) {
+    for (size_t i = 0; i < size; ++i) {
+      *out++ = ring[(head + i) % capacity];
+    }
+    head = 0;
+    size = 0;
+    return out;
+  }
+};
+
+// Registry of the (per-thread) free queues. Any access of a queue requires holding its mutex.
+//
+// The number of pending frees is only decreased after they were applied, i.e., a reader that
+// observes no pending frees also does not observe stale entries of the allocation map.
+class PendingFrees final {
+ public:
+  struct Queue final {
+    FreeQueueMutex mutex;
+    FreeQueue queue;
+  };
+
+ private:
+  // Number of slots of the counting filter, must be a power of two.
+  static constexpr size_t filter_size = 4096;
+  static_assert(__builtin_popcountll(filter_size) == 1);
+
+  FreeQueueMutex registry_mutex;
+  std::vector<Queue*> queues;
+  std::atomic<size_t> pending{0};
+  // Counts pending frees per address hash, rules out a pending free of an address without locking.
+  std::array<std::atomic<std::uint32_t>, filter_size> filter{};
+
+  static inline size_t filter_index_for(const void* addr) {
+    const auto value = reinterpret_cast<uintptr_t>(addr);
+    return ((value >> 4U) ^ (value >> 16U)) & (filter_size - 1);
+  }
+
+ public:
+  inline void add(Queue* queue) {
+    std::lock_guard<FreeQueueMutex> guard(registry_mutex);
+    queues.push_back(queue);
+  }
+
+  inline void remove(Queue* queue) {
+    std::lock_guard<FreeQueueMutex> guard(registry_mutex);
+    queues.erase(std::remove(queues.begin(), queues.end(), queue), queues.end());
+  }
+
+  [[nodiscard]] inline bool any() const {
+    return pending.load(std::memory_order_acquire) > 0;
+  }
+
+  [[nodiscard]] inline bool maybe_pending(const void* addr) const {
+    return any() && filter[filter_index_for(addr)].load(std::memory_order_acquire) > 0;
+  }
+
+  inline void push(Queue& queue, const void* addr) {
+    queue.queue.push(addr);
+    filter[filter_index_for(addr)].fetch_add(1, std::memory_order_relaxed);
+    pending.fetch_add(1, std::memory_order_release);
+  }
+
+  // Must be called once the free of addr, taken from a queue, was applied.
+  inline void release(const void* addr) {
+    filter[filter_index_for(addr)].fetch_sub(1, std::memory_order_release);
+    pending.fetch_sub(1, std::memory_order_release);
+  }
+
+  // Removes a pending free of addr from any queue, the caller applies it and calls release(addr).
+  inline bool cancel(const void* addr) {
+    std::lock_guard<FreeQueueMutex> guard(registry_mutex);
+    for (auto* queue : queues) {
+      std::lock_guard<FreeQueueMutex> queue_guard(queue->mutex);
+      if (queue->queue.erase(addr)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  template <typename Callback>
+  inline void for_each(Callback&& callback) {
+    std::lock_guard<FreeQueueMutex> guard(registry_mutex);
+    for (auto* queue : queues) {
+      callback(*queue);
+    }
+  }
+};
+
+}  // namespace typeart::tracker
+
+#endif  // TYPEART_FREEQUEUE_H
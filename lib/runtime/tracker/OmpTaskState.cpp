@@ -0,0 +1,170 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "OmpTaskState.hpp"
+
+#include "runtime/Internals.hpp"
+#include "runtime/tracker/Tracker.hpp"
+#include "support/Logger.hpp"
+
+#if __has_include(<omp-tools.h>)
+#include <omp-tools.h>
+#define TYPEART_OMPT 1
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <string>
+
+extern "C" ompt_start_tool_result_t* ompt_start_tool(unsigned int omp_version, const char* runtime_version);
+#endif
+
+namespace typeart::tracker::omp {
+
+namespace {
+struct TaskState final {
+  RuntimeT::Stack stackVars;
+};
+
+// The explicit task executed by this thread, nullptr for implicit tasks (i.e., the per-thread stack is used).
+thread_local TaskState* current_task{nullptr};
+}  // namespace
+
+RuntimeT::Stack* current_task_stack() {
+  return current_task != nullptr ? &current_task->stackVars : nullptr;
+}
+
+#ifdef TYPEART_OMPT
+namespace {
+using start_tool_t = ompt_start_tool_result_t* (*)(unsigned int, const char*);
+
+// The tool of OMP_TOOL_LIBRARIES used in place of TypeART if the task callbacks are not supported.
+ompt_start_tool_result_t* next_tool{nullptr};
+
+// The arguments of ompt_start_tool, the next tool is only started once TypeART failed to initialize.
+struct StartArgs final {
+  unsigned int omp_version{0};
+  const char* runtime_version{nullptr};
+};
+StartArgs start_args;
+
+bool is_enabled() {
+  const char* ompt = std::getenv("TYPEART_OMPT");
+  return ompt != nullptr && strcmp(ompt, "") != 0 && strcmp(ompt, "0") != 0;
+}
+
+// Starts the first tool of the (colon-separated) OMP_TOOL_LIBRARIES, as the OpenMP runtime does if no tool is found
+// in the address space of the program. Libraries without a (started) tool are closed again.
+ompt_start_tool_result_t* start_next_tool(start_tool_t self, unsigned int omp_version,
+                                          const char* runtime_version) {
+  const char* libraries = std::getenv("OMP_TOOL_LIBRARIES");
+  if (libraries == nullptr) {
+    return nullptr;
+  }
+  const std::string tools{libraries};
+  std::string::size_type begin{0};
+  while (begin <= tools.size()) {
+    const auto end     = std::min(tools.find(':', begin), tools.size());
+    const auto library = tools.substr(begin, end - begin);
+    begin              = end + 1;
+    if (library.empty()) {
+      continue;
+    }
+    auto* handle = dlopen(library.c_str(), RTLD_LAZY);
+    if (handle == nullptr) {
+      continue;
+    }
+    auto start_tool = reinterpret_cast<start_tool_t>(dlsym(handle, "ompt_start_tool"));
+    if (start_tool != nullptr && start_tool != self) {
+      if (auto* result = start_tool(omp_version, runtime_version); result != nullptr) {
+        return result;
+      }
+    }
+    dlclose(handle);
+  }
+  return nullptr;
+}
+
+void on_task_create(ompt_data_t*, const ompt_frame_t*, ompt_data_t* new_task_data, int flags, int, const void*) {
+  if ((flags & ompt_task_explicit) == 0) {
+    new_task_data->ptr = nullptr;
+    return;
+  }
+  new_task_data->ptr = new TaskState{};
+}
+
+void on_task_schedule(ompt_data_t* prior_task_data, ompt_task_status_t prior_task_status,
+                      ompt_data_t* next_task_data) {
+  const bool prior_done = prior_task_status == ompt_task_complete || prior_task_status == ompt_task_cancel ||
+                          prior_task_status == ompt_task_detach;
+  if (prior_done && prior_task_data != nullptr && prior_task_data->ptr != nullptr) {
+    auto* task = static_cast<TaskState*>(prior_task_data->ptr);
+    if (!task->stackVars.empty()) {
+      // E.g., a cancelled task
+      auto guard = ScopeGuard{};
+      Tracker::get().onLeaveTask(task->stackVars);
+    }
+    delete task;
+    prior_task_data->ptr = nullptr;
+  }
+  current_task = next_task_data != nullptr ? static_cast<TaskState*>(next_task_data->ptr) : nullptr;
+}
+
+int initialize(ompt_function_lookup_t lookup, int, ompt_data_t*) {
+  auto set_callback = reinterpret_cast<ompt_set_callback_t>(lookup("ompt_set_callback"));
+  if (set_callback == nullptr) {
+    return 0;
+  }
+  const auto create   = set_callback(ompt_callback_task_create, reinterpret_cast<ompt_callback_t>(&on_task_create));
+  const auto schedule = set_callback(ompt_callback_task_schedule, reinterpret_cast<ompt_callback_t>(&on_task_schedule));
+  if (create != ompt_set_always || schedule != ompt_set_always) {
+    LOG_WARNING("OMPT task callbacks are not supported, stack allocations of tasks are tracked per thread.");
+    return 0;
+  }
+  return 1;
+}
+
+int initialize_or_chain(ompt_function_lookup_t lookup, int initial_device_num, ompt_data_t* tool_data) {
+  if (initialize(lookup, initial_device_num, tool_data) != 0) {
+    return 1;
+  }
+  // Returning 0 deactivates tools altogether, hence, the slot is passed on to the next tool.
+  next_tool = start_next_tool(&ompt_start_tool, start_args.omp_version, start_args.runtime_version);
+  if (next_tool == nullptr || next_tool->initialize == nullptr) {
+    return 0;
+  }
+  LOG_DEBUG("Passing OMPT on to the next tool of OMP_TOOL_LIBRARIES");
+  return next_tool->initialize(lookup, initial_device_num, &next_tool->tool_data);
+}
+
+void finalize(ompt_data_t*) {
+  if (next_tool != nullptr && next_tool->finalize != nullptr) {
+    next_tool->finalize(&next_tool->tool_data);
+  }
+}
+}  // namespace
+#endif
+
+}  // namespace typeart::tracker::omp
+
+#ifdef TYPEART_OMPT
+// Opt-in with TYPEART_OMPT=1, otherwise the OpenMP runtime continues its search for a tool (e.g., OMP_TOOL_LIBRARIES).
+extern "C" ompt_start_tool_result_t* ompt_start_tool(unsigned int omp_version, const char* runtime_version) {
+  using namespace typeart::tracker::omp;
+  if (!is_enabled()) {
+    return nullptr;
+  }
+  start_args = StartArgs{omp_version, runtime_version};
+  static ompt_start_tool_result_t tool{&initialize_or_chain, &finalize, ompt_data_none};
+  return &tool;
+}
+#endif
@@ -0,0 +1,29 @@
+// TypeART library
+//
+// Copyright (c) 2017-2022 TypeART Authors
+// Distributed under the BSD 3-Clause license.
+// (See accompanying file LICENSE.txt or copy at
+// https://opensource.org/licenses/BSD-3-Clause)
+//
+// Project home: https://github.com/tudasc/TypeART
+//
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#ifndef TYPEART_OMPTASKSTATE_H
+#define TYPEART_OMPTASKSTATE_H
+
+#include "Types.hpp"
+
+namespace typeart::tracker::omp {
+
+// Explicit OpenMP tasks may be suspended and resumed (untied tasks even on another thread), hence the stack
+// allocations of a task are recorded per task instead of per thread. The task state is maintained with the
+// OMPT task create/schedule callbacks, if the OpenMP runtime supports OMPT and the tool is enabled with TYPEART_OMPT=1.
+//
+// Returns the stack allocations of the explicit task currently executed by the calling thread, or nullptr.
+RuntimeT::Stack* current_task_stack();
+
+}  // namespace typeart::tracker::omp
+
+#endif  // TYPEART_OMPTASKSTATE_H
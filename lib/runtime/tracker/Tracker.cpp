@@ -13,9 +13,11 @@
 #include "runtime/tracker/Tracker.hpp"
 
 #include "CallbackInterface.h"
+#include "OmpTaskState.hpp"
 #include "meta/Database.hpp"
 #include "runtime/AccessCounter.hpp"
 #include "runtime/Internals.hpp"
+#include "runtime/LookupCache.hpp"
 #include "runtime/Runtime.hpp"
 #include "support/Logger.hpp"
 
@@ -23,8 +25,12 @@
 #include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <iterator>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
@@ -87,6 +93,7 @@ inline typename std::underlying_type<Enum>::type operator==(Enum lhs, Enum rhs)
 namespace {
 struct ThreadData final {
   RuntimeT::Stack stackVars;
+  std::vector<std::pair<const void*, RuntimeT::MappedType>> bulkEntries;
 
   ThreadData() {
     stackVars.reserve(RuntimeT::StackReserve);
@@ -95,9 +102,70 @@ struct ThreadData final {
 
 thread_local ThreadData threadData;
 
+// Stack allocations of the current (explicit) OpenMP task, or of the thread.
+inline RuntimeT::Stack& currentStack() {
+  if (auto* task_stack = omp::current_task_stack(); task_stack != nullptr) {
+    return *task_stack;
+  }
+  return threadData.stackVars;
+}
+
+PendingFrees pendingFrees;
+
+// The free queue of a thread is registered on first use. Its pending frees are applied on thread exit.
+struct FreeQueueHandle final {
+  std::unique_ptr<PendingFrees::Queue> queue;
+
+  PendingFrees::Queue& get() {
+    if (unlikely(!queue)) {
+      queue = std::make_unique<PendingFrees::Queue>();
+      pendingFrees.add(queue.get());
+    }
+    return *queue;
+  }
+
+  ~FreeQueueHandle() {
+    if (queue) {
+      Tracker::get().flushPendingFrees();
+      pendingFrees.remove(queue.get());
+    }
+  }
+};
+
+thread_local FreeQueueHandle freeQueue;
+
+// The meta id of a record was validated by doAlloc.
+inline PointerInfo toPointerInfo(const void* addr, const RuntimeT::MappedType& record) {
+  const auto alloc = meta::dyn_cast<meta::Allocation>(getDatabase().getMeta(record.getMetaId()));
+  assert(alloc != nullptr && "Invalid meta id in allocation record");
+  return PointerInfo{pointer{addr}, *alloc, alloc->get_type(), record.getCount()};
+}
+
+inline FreeState recordFreeHeap(const void* addr, const RuntimeT::MappedType& removed) {
+  // The record is only expanded if it is logged or recorded, LOG_TRACE does not evaluate its arguments otherwise.
+  LOG_TRACE("Free heap {}", toPointerInfo(addr, removed));
+
+  if constexpr (!std::is_same_v<Recorder, softcounter::NoneRecorder>) {
+    const auto pointer_info = toPointerInfo(addr, removed);
+    auto& meta = pointer_info.getAllocation();
+    auto alloc = meta::dyn_cast<meta::HeapAllocation>(&meta);
+    if (unlikely(alloc == nullptr)) {
+      LOG_ERROR("Unexpected meta type. Expected HeapAllocation, but found {}", meta.get_kind());
+      return FreeState::ERROR;
+    }
+    getRecorder().incHeapFree(alloc, pointer_info.getCount());
+  }
+  return FreeState::OK;
+}
+
 }  // namespace
 
 Tracker::Tracker() {
+  const char* deferred = std::getenv("TYPEART_DEFERRED_FREE");
+  deferred_free        = deferred != nullptr && strcmp(deferred, "") != 0 && strcmp(deferred, "0") != 0;
+  if (deferred_free) {
+    LOG_DEBUG("Deferred heap free processing enabled");
+  }
 }
 
 void Tracker::onAlloc(const void* addr, meta::meta_id_t meta_id, size_t count, const void* retAddr) {
@@ -127,7 +195,7 @@ void Tracker::onAllocStack(const void* addr, meta::meta_id_t meta_id, size_t cou
       return;
     }
     if (!(status & AllocState::ADDR_SKIPPED)) {
-      threadData.stackVars.push_back(addr);
+      currentStack().push_back(addr);
       getRecorder().incStackAlloc(alloc, count);
     }
     auto pointer_info = PointerInfo{pointer{addr}, *alloc, alloc->get_type(), count};
@@ -152,21 +220,62 @@ void Tracker::onAllocGlobal(const void* addr, meta::meta_id_t meta_id, size_t co
   }
 }
 
-AllocState Tracker::doAlloc(const void* addr, meta::meta_id_t meta_id, size_t count, const void* retAddr) {
+void Tracker::onAllocBulk(const void* const* addrs, meta::meta_id_t meta_id, const size_t* counts, size_t n,
+                          const void* retAddr) {
+  if (n == 0) {
+    return;
+  }
   const auto meta = getDatabase().getMeta(meta_id);
   if (unlikely(meta == nullptr)) {
-    LOG_ERROR("Allocation with unknown meta_id! Skipping...");
-    return AllocState::UNKNOWN_META_ID | AllocState::ADDR_SKIPPED;
+    LOG_ERROR("Bulk allocation with unknown meta_id! Skipping {} allocations...", n);
+    return;
+  }
+  const auto alloc = meta::dyn_cast<meta::HeapAllocation>(meta);
+  if (unlikely(alloc == nullptr)) {
+    LOG_ERROR("Unexpected meta type. Expected HeapAllocation, but found {}", meta->get_kind());
+    return;
+  }
+
+  auto& recorder = getRecorder();
+  auto& entries  = threadData.bulkEntries;
+  entries.clear();
+  entries.reserve(n);
+  for (size_t i = 0; i < n; ++i) {
+    const auto pointer_info = PointerInfo{pointer{addrs[i]}, *alloc, alloc->get_type(), counts[i]};
+    const auto status       = checkAlloc(pointer_info);
+    if (status & AllocState::ADDR_SKIPPED) {
+      continue;
+    }
+    if (deferred_free && pendingFrees.maybe_pending(addrs[i])) {
+      applyPendingFree(addrs[i], retAddr);
+    }
+    entries.emplace_back(addrs[i], RuntimeT::MappedType{meta_id, counts[i]});
+    recorder.incHeapAlloc(alloc, counts[i]);
+    LOG_TRACE("Alloc heap {}", pointer_info);
   }
-  const auto alloc = meta::dyn_cast<meta::Allocation>(meta);
 
+  // Stable, such that the last of duplicate addresses is kept, as with consecutive single allocations.
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  wrapper.put_range(entries.cbegin(), entries.cend(), [&](bool overridden, const void* addr) {
+    if (unlikely(overridden)) {
+      lookup_cache::invalidate(addr);
+      recorder.incAddrReuse();
+      LOG_WARNING("Pointer already in map {} ({})", addr, retAddr);
+    }
+  });
+}
+
+AllocState Tracker::checkAlloc(const PointerInfo& pointer_info) {
   AllocState status = AllocState::NO_INIT;
   auto& recorder    = getRecorder();
 
+  const auto addr  = pointer_info.getBaseAddr().get();
+  const auto count = pointer_info.getCount();
+
   // Calling malloc with size 0 may return a nullptr or some address that can not be written to.
   // In the second case, the allocation is tracked anyway so that onFree() does not report an error.
   // On the other hand, an allocation on address 0x0 with size > 0 is an actual error.
-  const auto pointer_info = PointerInfo{pointer{addr}, *alloc, alloc->get_type(), count};
   if (unlikely(count == 0)) {
     recorder.incZeroLengthAddr();
     status |= AllocState::ZERO_COUNT;
@@ -180,10 +289,37 @@ AllocState Tracker::doAlloc(const void* addr, meta::meta_id_t meta_id, size_t co
     recorder.incNullAddr();
     LOG_ERROR("Nullptr allocation {}", pointer_info);
     return status | AllocState::NULL_PTR | AllocState::ADDR_SKIPPED;
+  } else if (unlikely(count > RuntimeT::MappedType::max_count)) {
+    LOG_ERROR("Allocation count exceeds the maximum of {} {}", RuntimeT::MappedType::max_count, pointer_info);
+    return status | AllocState::ADDR_SKIPPED;
   }
 
-  const auto overridden = wrapper.put(addr, pointer_info);
+  return status;
+}
+
+AllocState Tracker::doAlloc(const void* addr, meta::meta_id_t meta_id, size_t count, const void* retAddr) {
+  const auto meta = getDatabase().getMeta(meta_id);
+  if (unlikely(meta == nullptr)) {
+    LOG_ERROR("Allocation with unknown meta_id! Skipping...");
+    return AllocState::UNKNOWN_META_ID | AllocState::ADDR_SKIPPED;
+  }
+  const auto alloc = meta::dyn_cast<meta::Allocation>(meta);
+
+  const auto pointer_info = PointerInfo{pointer{addr}, *alloc, alloc->get_type(), count};
+  auto status             = checkAlloc(pointer_info);
+  if (status & AllocState::ADDR_SKIPPED) {
+    return status;
+  }
+
+  // A pending free of addr would otherwise be reported as address reuse (and later remove this allocation).
+  if (deferred_free && pendingFrees.maybe_pending(addr)) {
+    applyPendingFree(addr, retAddr);
+  }
+
+  auto& recorder        = getRecorder();
+  const auto overridden = wrapper.put(addr, RuntimeT::MappedType{meta_id, count});
   if (unlikely(overridden)) {
+    lookup_cache::invalidate(addr);
     recorder.incAddrReuse();
     status |= AllocState::ADDR_REUSE;
     LOG_WARNING("Pointer already in map {}", pointer_info);
@@ -197,74 +333,165 @@ FreeState Tracker::doFreeHeap(const void* addr, const void* retAddr) {
     LOG_TRACE("Free on nullptr ({})", retAddr);
     return FreeState::ADDR_SKIPPED | FreeState::NULL_PTR;
   }
-  llvm::Optional<PointerInfo> removed = wrapper.remove(addr);
+  llvm::Optional<RuntimeT::MappedType> removed = wrapper.remove(addr);
 
   if (unlikely(!removed)) {
     LOG_TRACE("Free on unregistered address {} ({})", addr, retAddr);
     return FreeState::ADDR_SKIPPED | FreeState::UNREG_ADDR;
   }
+  lookup_cache::invalidate(addr);
 
-  LOG_TRACE("Free heap {}", *removed);
+  return recordFreeHeap(addr, *removed);
+}
 
-  if constexpr (!std::is_same_v<Recorder, softcounter::NoneRecorder>) {
-    auto& meta = removed->getAllocation();
-    auto alloc = meta::dyn_cast<meta::HeapAllocation>(&meta);
-    if (unlikely(alloc == nullptr)) {
-      LOG_ERROR("Unexpected meta type. Expected HeapAllocation, but found {}", meta.get_kind());
-      return FreeState::ERROR;
+void Tracker::onFreeHeap(const void* addr, const void* retAddr) {
+  if (deferred_free && likely(addr != nullptr)) {
+    deferFreeHeap(addr);
+    return;
+  }
+  const auto status = doFreeHeap(addr, retAddr);
+  if (FreeState::OK == status) {
+    getRecorder().decHeapAlloc();
+  }
+}
+
+void Tracker::deferFreeHeap(const void* addr) {
+  auto& queue = freeQueue.get();
+  {
+    std::lock_guard<FreeQueueMutex> guard(queue.mutex);
+    if (queue.queue.full()) {
+      drainFreeQueue(queue);
     }
-    getRecorder().incHeapFree(alloc, removed->getCount());
+    pendingFrees.push(queue, addr);
   }
-  return FreeState::OK;
+  // After the push: A lookup missing the cache observes the pending free and drains the queues first.
+  lookup_cache::invalidate(addr);
 }
 
-void Tracker::onFreeHeap(const void* addr, const void* retAddr) {
+void Tracker::drainFreeQueue(PendingFrees::Queue& queue) {
+  // Not part of threadData, the queue may be drained on thread exit.
+  std::array<const void*, FreeQueue::capacity> batch;
+  const auto batch_begin = batch.begin();
+  const auto batch_end   = queue.queue.take(batch_begin);
+  if (batch_begin == batch_end) {
+    return;
+  }
+
+  // Sorted, such that consecutive removals hit the same, already cached, tree nodes.
+  std::sort(batch_begin, batch_end);
+  LOG_TRACE("Applying {} deferred heap frees...", std::distance(batch_begin, batch_end));
+
+  auto& recorder = getRecorder();
+  wrapper.remove_range(batch_begin, batch_end, [&](llvm::Optional<RuntimeT::MappedType>& removed, const void* addr) {
+    if (unlikely(!removed)) {
+      LOG_TRACE("Free on unregistered address {}", addr);
+      return;
+    }
+    if (FreeState::OK == recordFreeHeap(addr, *removed)) {
+      recorder.decHeapAlloc();
+    }
+  });
+
+  std::for_each(batch_begin, batch_end, [](const void* addr) { pendingFrees.release(addr); });
+}
+
+bool Tracker::applyPendingFree(const void* addr, const void* retAddr) {
+  if (!pendingFrees.cancel(addr)) {
+    return false;
+  }
   const auto status = doFreeHeap(addr, retAddr);
   if (FreeState::OK == status) {
     getRecorder().decHeapAlloc();
   }
+  pendingFrees.release(addr);
+  return true;
+}
+
+void Tracker::flushPendingFrees() {
+  pendingFrees.for_each([&](PendingFrees::Queue& queue) {
+    std::lock_guard<FreeQueueMutex> guard(queue.mutex);
+    drainFreeQueue(queue);
+  });
 }
 
 void Tracker::onLeaveScope(int alloca_count, const void* retAddr) {
-  if (unlikely(alloca_count > static_cast<int>(threadData.stackVars.size()))) {
+  doLeaveScope(currentStack(), alloca_count, retAddr);
+}
+
+void Tracker::onLeaveTask(RuntimeT::Stack& task_stack) {
+  LOG_TRACE("Freeing {} remaining stack entries of task...", task_stack.size());
+  doLeaveScope(task_stack, static_cast<int>(task_stack.size()), nullptr);
+}
+
+void Tracker::doLeaveScope(RuntimeT::Stack& stack, int alloca_count, const void* retAddr) {
+  if (unlikely(alloca_count > static_cast<int>(stack.size()))) {
     LOG_ERROR("Stack is smaller than requested de-allocation count. alloca_count: {}. size: {}", alloca_count,
-              threadData.stackVars.size());
-    alloca_count = threadData.stackVars.size();
+              stack.size());
+    alloca_count = stack.size();
   }
 
-  const auto cend      = threadData.stackVars.cend();
+  const auto cend      = stack.cend();
   const auto start_pos = (cend - alloca_count);
   LOG_TRACE("Freeing {} stack entries...", alloca_count);
 
   auto& recorder = getRecorder();
-  wrapper.remove_range(start_pos, cend, [&](llvm::Optional<PointerInfo>& removed, const void* addr) {
+  wrapper.remove_range(start_pos, cend, [&](llvm::Optional<RuntimeT::MappedType>& removed, const void* addr) {
     if (unlikely(!removed)) {
       LOG_TRACE("Free on unregistered address {} ({})", addr, retAddr);
     } else {
-      LOG_TRACE("Free stack {}", *removed);
+      lookup_cache::invalidate(addr);
+      LOG_TRACE("Free stack {}", toPointerInfo(addr, *removed));
       if constexpr (!std::is_same_v<Recorder, softcounter::NoneRecorder>) {
-        auto& meta = removed->getAllocation();
+        const auto pointer_info = toPointerInfo(addr, *removed);
+        auto& meta = pointer_info.getAllocation();
         auto alloc = meta::dyn_cast<meta::StackAllocation>(&meta);
         if (unlikely(alloc == nullptr)) {
           LOG_ERROR("Unexpected meta type. Expected StackAllocation, but found {}", meta.get_kind());
           return;
         }
-        recorder.incStackFree(alloc, removed->getCount());
+        recorder.incStackFree(alloc, pointer_info.getCount());
       }
     }
   });
 
-  threadData.stackVars.erase(start_pos, cend);
+  stack.erase(start_pos, cend);
   recorder.decStackAlloc(alloca_count);
-  LOG_TRACE("{} remaining stack entries after free!", threadData.stackVars.size());
+  LOG_TRACE("{} remaining stack entries after free!", stack.size());
 }
 // Base address
 std::optional<PointerInfo> Tracker::getPointerInfo(const void* addr) {
-  auto result = wrapper.find(addr);
-  if (result.hasValue()) {
-    return result->second;
+  while (true) {
+    const auto result = wrapper.find(addr);
+    if (!result.hasValue()) {
+      return {};
+    }
+    // Only a pending free of the found allocation itself makes the result stale, other pending frees stay queued.
+    if (deferred_free && pendingFrees.maybe_pending(result->first) && applyPendingFree(result->first, nullptr)) {
+      continue;
+    }
+    return toPointerInfo(result->first, result->second);
+  }
+}
+
+void Tracker::getPointerInfoBatch(const void* const* sorted_addrs, size_t n, std::optional<PointerInfo>* infos) {
+  size_t index{0};
+  const auto* end = sorted_addrs + n;
+  wrapper.find_range(sorted_addrs, end,
+                     [&](const void*, const llvm::Optional<RuntimeT::MapEntry>& result) {
+                       auto& info = infos[index++];
+                       if (!info.has_value() && result.hasValue()) {
+                         info = toPointerInfo(result->first, result->second);
+                       }
+                     });
+  if (!deferred_free || !pendingFrees.any()) {
+    return;
+  }
+  // Allocations with a pending free are looked up again, see getPointerInfo.
+  for (size_t i = 0; i < n; ++i) {
+    if (infos[i].has_value() && pendingFrees.maybe_pending(infos[i]->getBaseAddr().get())) {
+      infos[i] = getPointerInfo(sorted_addrs[i]);
+    }
   }
-  return {};
 }
 
 }  // namespace typeart::tracker
@@ -14,6 +14,7 @@
 #define TYPEART_ALLOCATIONTRACKING_H
 
 #include "AllocMapWrapper.hpp"
+#include "FreeQueue.hpp"
 #include "meta/Database.hpp"
 #include "runtime/AccessCounter.hpp"
 
@@ -52,6 +53,8 @@ enum class FreeState : unsigned {
 
 class Tracker {
   PointerMap wrapper;
+  // Heap frees are queued per thread and applied in batches, see TYPEART_DEFERRED_FREE.
+  bool deferred_free{false};
 
  public:
   static Tracker& get() {
@@ -69,16 +72,41 @@ class Tracker {
 
   void onAllocGlobal(const void* addr, meta::meta_id_t meta_id, size_t count, const void* retAddr);
 
+  void onAllocBulk(const void* const* addrs, meta::meta_id_t meta_id, const size_t* counts, size_t n,
+                   const void* retAddr);
+
   void onFreeHeap(const void* addr, const void* retAddr);
 
   void onLeaveScope(int alloca_count, const void* retAddr);
 
+  // Frees the remaining stack allocations of a finished OpenMP task.
+  void onLeaveTask(RuntimeT::Stack& task_stack);
+
   std::optional<PointerInfo> getPointerInfo(const void* addr);
 
+  // Looks up n addresses, sorted in ascending order, with a single pass over the allocation map.
+  // Only fills the entries of infos without a value.
+  void getPointerInfoBatch(const void* const* sorted_addrs, size_t n, std::optional<PointerInfo>* infos);
+
+  // Applies the pending (deferred) heap frees of all threads.
+  void flushPendingFrees();
+
  private:
+  AllocState checkAlloc(const PointerInfo& pointer_info);
+
   AllocState doAlloc(const void* addr, meta::meta_id_t meta_id, size_t count, const void* retAddr);
 
   FreeState doFreeHeap(const void* addr, const void* retAddr);
+
+  void doLeaveScope(RuntimeT::Stack& stack, int alloca_count, const void* retAddr);
+
+  void deferFreeHeap(const void* addr);
+
+  // Requires holding the mutex of the queue.
+  void drainFreeQueue(PendingFrees::Queue& queue);
+
+  // Applies a pending free of addr before addr is registered again (or looked up), returns true if there was one.
+  bool applyPendingFree(const void* addr, const void* retAddr);
 };
 
 }  // namespace typeart::tracker
@@ -48,24 +48,55 @@
 #endif
 
 #include <cstddef>  // size_t
+#include <cstdint>
 #include <vector>
 
 namespace typeart::tracker {
 
+// Value type of the pointer map. The base address is the map key and the type is derived from the allocation,
+// hence only the meta id of the allocation and the element count are stored.
+struct AllocationRecord final {
+  static constexpr size_t max_count = (size_t{1} << 48U) - 1;
+
+  AllocationRecord() : meta_id(meta::meta_id_t{}.value()), count(0) {
+  }
+
+  AllocationRecord(meta::meta_id_t meta_id, size_t count) : meta_id(meta_id.value()), count(count) {
+  }
+
+  inline meta::meta_id_t getMetaId() const {
+    return meta::meta_id_t{meta_id};
+  }
+
+  inline size_t getCount() const {
+    return count;
+  }
+
+  inline bool isValid() const {
+    return getMetaId() != meta::meta_id_t{};
+  }
+
+ private:
+  meta_id_value meta_id;
+  std::uint64_t count : 48;
+} __attribute__((packed));
+
+static_assert(sizeof(AllocationRecord) == sizeof(meta_id_value) + 6, "Allocation record is not packed");
+
 struct RuntimeT {
   using Stack = std::vector<const void*>;
   static constexpr auto StackReserve{512U};
   static constexpr char StackName[] = "std::vector";
 #ifdef TYPEART_PHMAP
-  using PointerMapBaseT           = phmap::btree_map<const void*, PointerInfo>;
+  using PointerMapBaseT           = phmap::btree_map<const void*, AllocationRecord>;
   static constexpr char MapName[] = "phmap::btree_map";
 #endif
 #ifdef TYPEART_ABSEIL
-  using PointerMapBaseT           = absl::btree_map<const void*, PointerInfo>;
+  using PointerMapBaseT           = absl::btree_map<const void*, AllocationRecord>;
   static constexpr char MapName[] = "absl::btree_map";
 #endif
 #if !defined(TYPEART_PHMAP) && !defined(TYPEART_ABSEIL)
-  using PointerMapBaseT           = std::map<const void*, PointerInfo>;
+  using PointerMapBaseT           = std::map<const void*, AllocationRecord>;
   static constexpr char MapName[] = "std::map";
 #endif
 #ifdef USE_SAFEPTR
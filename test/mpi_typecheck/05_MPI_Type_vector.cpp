@@ -21,6 +21,11 @@ int main(int argc, char** argv) {
   MPI_Type_set_name(mpi_double_vec, "test_type");
   MPI_Type_commit(&mpi_double_vec);
 
+  MPI_Datatype mpi_empty_vec;
+  MPI_Type_vector(0, 2, 3, MPI_DOUBLE, &mpi_empty_vec);
+  MPI_Type_set_name(mpi_empty_vec, "empty_type");
+  MPI_Type_commit(&mpi_empty_vec);
+
   double f[8];
   padded_array<7> too_small;
 
@@ -37,9 +42,17 @@ int main(int argc, char** argv) {
   // clang-format on
   run_test(too_small, 1, mpi_double_vec);
 
-  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 2 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
-  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 2 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // An empty vector requires no elements
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[8]] against 1 element of MPI type "empty_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[8]] against 1 element of MPI type "empty_type"
+  // clang-format on
+  run_test(f, 1, mpi_empty_vec);
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 3 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 3 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
   // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 1 }
+  MPI_Type_free(&mpi_empty_vec);
   MPI_Type_free(&mpi_double_vec);
   MPI_Finalize();
   return 0;
@@ -13,27 +13,35 @@
 int main(int argc, char** argv) {
   MPI_Init(&argc, &argv);
 
-  double send_buffer[2] = {1.0};
-  int send_count[2]     = {0};
-  int send_displys[2]   = {0};
+  // The neighborhood collectives need a process topology
+  int dims[1]    = {2};
+  int periods[1] = {0};
+  MPI_Comm cart_comm;
+  MPI_Cart_create(MPI_COMM_WORLD, 1, dims, periods, 0, &cart_comm);
 
-  double recv_buffer[2] = {0.0};
-  int recv_count[2]     = {0};
-  int recv_displys[2]   = {0};
+  double send_buffer[2]    = {1.0};
+  int send_count[2]        = {0};
+  MPI_Aint send_displys[2] = {0};
+
+  double recv_buffer[2]    = {0.0};
+  int recv_count[2]        = {0};
+  MPI_Aint recv_displys[2] = {0};
 
   MPI_Datatype mpi_type[2] = {MPI_DOUBLE, MPI_DOUBLE};
 
   MPI_Request mpi_req[2];
 
   // clang-format off
-  MPI_Alltoallw(send_buffer, send_count, send_displys, mpi_type,
-                recv_buffer, recv_count, recv_displys, mpi_type,
-                MPI_COMM_WORLD);
+  MPI_Neighbor_alltoallw(send_buffer, send_count, send_displys, mpi_type,
+                         recv_buffer, recv_count, recv_displys, mpi_type,
+                         cart_comm);
 
-  MPI_Ialltoallw(send_buffer, send_count, send_displys, mpi_type,
-                 recv_buffer, recv_count, recv_displys, mpi_type,
-                 MPI_COMM_WORLD, &mpi_req[0]);
+  MPI_Ineighbor_alltoallw(send_buffer, send_count, send_displys, mpi_type,
+                          recv_buffer, recv_count, recv_displys, mpi_type,
+                          cart_comm, &mpi_req[0]);
   // clang-format on
+  MPI_Wait(&mpi_req[0], MPI_STATUS_IGNORE);
+  MPI_Comm_free(&cart_comm);
 
   MPI_Barrier(MPI_COMM_WORLD);
 
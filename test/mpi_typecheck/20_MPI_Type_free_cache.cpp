@@ -0,0 +1,59 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  MPI_Datatype first_type;
+  MPI_Type_contiguous(4, MPI_DOUBLE, &first_type);
+  MPI_Type_set_name(first_type, "first_type");
+  MPI_Type_commit(&first_type);
+
+  double f[8];
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[8]] against 2 elements of MPI type "first_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[8]] against 2 elements of MPI type "first_type"
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[8]] against 1 element of MPI type "first_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[8]] against 1 element of MPI type "first_type"
+  // clang-format on
+  run_test(f, 2, first_type);
+  run_test(f, 1, first_type);
+
+  MPI_Type_free(&first_type);
+
+  // The handle of the freed type may be reused, the cached decoding of first_type must not be applied
+  MPI_Datatype second_type;
+  MPI_Type_contiguous(2, MPI_INT, &second_type);
+  MPI_Type_set_name(second_type, "second_type");
+  MPI_Type_commit(&second_type);
+
+  int i[4];
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x int[4]] against 2 elements of MPI type "second_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x int[4]] against 2 elements of MPI type "second_type"
+  // CHECK-NOT: R[{{0|1}}][Error]{{.*}}
+  // clang-format on
+  run_test(i, 2, second_type);
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 3 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 3 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 0 }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] TCounter { Hit: 1 Miss: 2 Invalidated: 2 }
+  MPI_Type_free(&second_type);
+  MPI_Finalize();
+  return 0;
+}
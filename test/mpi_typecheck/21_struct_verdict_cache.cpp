@@ -0,0 +1,78 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include <mpi.h>
+
+struct S1 {
+  double a[2];
+  int b;
+  double c;
+};
+
+// Storage for the 3 elements received, while the checked buffer has the type [2 x S1], see padded_array
+struct padded_pair {
+  double offset;
+  padded_pair pair;
+  S1 padding;
+};
+
+void run_test(void* data, int count, MPI_Datatype type) {
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    MPI_Send(data, count, type, 1, 0, MPI_COMM_WORLD);
+  } else {
+    MPI_Recv(data, count, type, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+  }
+}
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  int counts[3]         = {2, 1, 1};
+  MPI_Aint offsets[3]   = {offsetof(S1, a), offsetof(S1, b), offsetof(S1, c)};
+  MPI_Datatype types[3] = {MPI_DOUBLE, MPI_INT, MPI_DOUBLE};
+  MPI_Datatype s1_type;
+  MPI_Type_create_struct(3, counts, offsets, types, &s1_type);
+  MPI_Type_set_name(s1_type, "s1_type");
+  MPI_Type_commit(&s1_type);
+
+  S1 first;
+  S1 second;
+  S1 pair[2];
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x S1] against 1 element of MPI type "s1_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x S1] against 1 element of MPI type "s1_type"
+  // clang-format on
+  run_test(&first, 1, s1_type);
+
+  // The struct layout was already verified against s1_type, only the counts are compared
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x S1] against 1 element of MPI type "s1_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x S1] against 1 element of MPI type "s1_type"
+  // clang-format on
+  run_test(&second, 1, s1_type);
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x S1[2]] against 3 elements of MPI type "s1_type": buffer too small (2 elements, 3 required)
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x S1[2]] against 3 elements of MPI type "s1_type": buffer too small (2 elements, 3 required)
+  // clang-format on
+  run_test(pair.pair, 3, s1_type);
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 3 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 3 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 1 }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] VCounter { Hit: 2 Miss: 2 }
+  MPI_Type_free(&s1_type);
+  MPI_Finalize();
+  return 0;
+}
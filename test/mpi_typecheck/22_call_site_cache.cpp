@@ -0,0 +1,50 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+constexpr auto n = 16;
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  auto* d = new double[n];
+
+  // Same call site and arguments in each iteration, only the first one is checked
+  // clang-format off
+  // RANK0-COUNT-3: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [16 x double] against 16 elements of MPI type "MPI_DOUBLE"
+  // RANK1-COUNT-3: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [16 x double] against 16 elements of MPI type "MPI_DOUBLE"
+  // CHECK-NOT: R[{{0|1}}][Error]{{.*}}
+  // clang-format on
+  for (int i = 0; i < 3; ++i) {
+    run_test(d, n, MPI_DOUBLE);
+  }
+
+  // The freed buffer's address may be reused, the verdict for d must not be applied
+  delete[] d;
+  auto* ints = new int[2 * n];
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [32 x int] against 16 elements of MPI type "MPI_DOUBLE": expected a type matching MPI type "MPI_DOUBLE", but found type "int"
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [32 x int] against 16 elements of MPI type "MPI_DOUBLE": expected a type matching MPI type "MPI_DOUBLE", but found type "int"
+  // clang-format on
+  run_test(ints, n, MPI_DOUBLE);
+  delete[] ints;
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 4 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 4 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 1 }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] SCounter { Hit: 2 Miss: 2 }
+  MPI_Finalize();
+  return 0;
+}
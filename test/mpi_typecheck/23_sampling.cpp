@@ -0,0 +1,40 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: TYPEART_SAMPLING_RATE=4 TYPEART_SAMPLING_FIRST=2 %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+constexpr auto n = 16;
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  double f[n];
+
+  // The first two calls and then every fourth call (i.e., calls 0, 1, 2 and 6) are checked
+  // clang-format off
+  // RANK0-COUNT-4: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[16]] against 16 elements of MPI type "MPI_DOUBLE"
+  // RANK1-COUNT-4: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[16]] against 16 elements of MPI type "MPI_DOUBLE"
+  // CHECK-NOT: successfully checked
+  // clang-format on
+  for (int i = 0; i < 10; ++i) {
+    run_test(f, n, MPI_DOUBLE);
+  }
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 10 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 10 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 0 }
+  // RANK0: R[0]T[{{[0-9]*}}][Info] Sampling { Function: MPI_Send Sampled: 4 Skipped: 6 }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] Sampling { Function: MPI_Recv Sampled: 4 Skipped: 6 }
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,53 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: TYPEART_ASYNC_CHECKS=1 %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+constexpr auto n = 16;
+
+void run_nonblocking_test(void* data, int count, MPI_Datatype type) {
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Request request;
+  if (rank == 0) {
+    MPI_Isend(data, count, type, 1, 0, MPI_COMM_WORLD, &request);
+  } else {
+    MPI_Irecv(data, count, type, 0, 0, MPI_COMM_WORLD, &request);
+  }
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+}
+
+int main(int argc, char** argv) {
+  int provided;
+  MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  double f[n];
+  padded_array<n> too_small;
+
+  // Errors of the helper thread are reported with the call site of the non-blocking call
+  // clang-format off
+  // RANK0-DAG: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Isend: successfully checked send-buffer 0x{{.*}} of type [1 x double[16]] against 16 elements of MPI type "MPI_DOUBLE"
+  // RANK1-DAG: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Irecv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[16]] against 16 elements of MPI type "MPI_DOUBLE"
+  // RANK0-DAG: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Isend: type error while checking send-buffer 0x{{.*}} of type [1 x double[16]] against 17 elements of MPI type "MPI_DOUBLE": buffer too small (16 elements, 17 required)
+  // RANK1-DAG: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Irecv: type error while checking recv-buffer 0x{{.*}} of type [1 x double[16]] against 17 elements of MPI type "MPI_DOUBLE": buffer too small (16 elements, 17 required)
+  // clang-format on
+  run_nonblocking_test(f, n, MPI_DOUBLE);
+  run_nonblocking_test(too_small.arr, n + 1, MPI_DOUBLE);
+
+  // All pending checks are done before the counters are reported
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 2 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 2 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 1 }
+  MPI_Finalize();
+  return 0;
+}
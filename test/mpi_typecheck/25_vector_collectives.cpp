@@ -0,0 +1,66 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  double send[4];
+  double recv[4];
+  padded_array<4> small_send;
+  padded_array<4> small_recv;
+  int counts[2] = {2, 2};
+
+  // The buffers must hold max(displs[i] + counts[i]) elements
+  // clang-format off
+  // CHECK: MPI_Alltoallv: successfully checked send-buffer 0x{{.*}} of type [1 x double[4]] against 4 elements of MPI type "MPI_DOUBLE"
+  // CHECK: MPI_Alltoallv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[4]] against 4 elements of MPI type "MPI_DOUBLE"
+  // CHECK: MPI_Alltoallv: type error while checking send-buffer 0x{{.*}} of type [1 x double[4]] against 5 elements of MPI type "MPI_DOUBLE": buffer too small (4 elements, 5 required)
+  // CHECK: MPI_Alltoallv: type error while checking recv-buffer 0x{{.*}} of type [1 x double[4]] against 5 elements of MPI type "MPI_DOUBLE": buffer too small (4 elements, 5 required)
+  // clang-format on
+  int displs[2] = {0, 2};
+  MPI_Alltoallv(send, counts, displs, MPI_DOUBLE, recv, counts, displs, MPI_DOUBLE, MPI_COMM_WORLD);
+  int overlong_displs[2] = {0, 3};
+  MPI_Alltoallv(small_send.arr, counts, overlong_displs, MPI_DOUBLE, small_recv.arr, counts, overlong_displs,
+                MPI_DOUBLE, MPI_COMM_WORLD);
+
+  // Each segment is checked against its own datatype
+  // clang-format off
+  // CHECK-COUNT-2: MPI_Alltoallw: successfully checked send-buffer 0x{{.*}} against 1 element of MPI type "MPI_DOUBLE"
+  // CHECK-COUNT-2: MPI_Alltoallw: successfully checked recv-buffer 0x{{.*}} against 1 element of MPI type "MPI_DOUBLE"
+  // CHECK-COUNT-2: MPI_Alltoallw: type error while checking send-buffer 0x{{.*}} against 1 element of MPI type "MPI_INT": expected a type matching MPI type "MPI_INT", but found type "double"
+  // CHECK-COUNT-2: MPI_Alltoallw: type error while checking recv-buffer 0x{{.*}} against 1 element of MPI type "MPI_INT": expected a type matching MPI type "MPI_INT", but found type "double"
+  // clang-format on
+  int segment_counts[2]        = {1, 1};
+  int byte_displs[2]           = {0, sizeof(double)};
+  MPI_Datatype double_types[2] = {MPI_DOUBLE, MPI_DOUBLE};
+  MPI_Datatype int_types[2]    = {MPI_INT, MPI_INT};
+  MPI_Alltoallw(send, segment_counts, byte_displs, double_types, recv, segment_counts, byte_displs, double_types,
+                MPI_COMM_WORLD);
+  MPI_Alltoallw(send, segment_counts, byte_displs, int_types, recv, segment_counts, byte_displs, int_types,
+                MPI_COMM_WORLD);
+
+  // The receive buffer is only checked at the root
+  // clang-format off
+  // CHECK: MPI_Gatherv: successfully checked send-buffer 0x{{.*}} of type [1 x double[4]] against 2 elements of MPI type "MPI_DOUBLE"
+  // RANK0: MPI_Gatherv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[4]] against 4 elements of MPI type "MPI_DOUBLE"
+  // RANK1-NOT: MPI_Gatherv: {{.*}} recv-buffer
+  // clang-format on
+  MPI_Gatherv(send, 2, MPI_DOUBLE, recv, counts, displs, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+  // CHECK: CCounter { Send: 0 Recv: 0 Send_Recv: 5 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 6 }
+  MPI_Finalize();
+  return 0;
+}
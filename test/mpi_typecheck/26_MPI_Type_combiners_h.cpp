@@ -0,0 +1,109 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+struct S1 {
+  double a;
+  int b;
+};
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  MPI_Datatype hvector_type;
+  MPI_Type_create_hvector(2, 2, 3 * sizeof(double), MPI_DOUBLE, &hvector_type);
+  MPI_Type_set_name(hvector_type, "hvector_type");
+  MPI_Type_commit(&hvector_type);
+
+  MPI_Datatype indexed_type;
+  MPI_Type_indexed(2, (int[2]){1, 2}, (int[2]){4, 0}, MPI_DOUBLE, &indexed_type);
+  MPI_Type_set_name(indexed_type, "indexed_type");
+  MPI_Type_commit(&indexed_type);
+
+  MPI_Datatype hindexed_type;
+  MPI_Type_create_hindexed(2, (int[2]){2, 1}, (MPI_Aint[2]){0, 4 * sizeof(double)}, MPI_DOUBLE, &hindexed_type);
+  MPI_Type_set_name(hindexed_type, "hindexed_type");
+  MPI_Type_commit(&hindexed_type);
+
+  MPI_Datatype s1_type;
+  MPI_Type_create_struct(2, (int[2]){1, 1}, (MPI_Aint[2]){offsetof(S1, a), offsetof(S1, b)},
+                         (MPI_Datatype[2]){MPI_DOUBLE, MPI_INT}, &s1_type);
+  MPI_Datatype resized_type;
+  MPI_Type_create_resized(s1_type, 0, sizeof(S1), &resized_type);
+  MPI_Type_set_name(resized_type, "resized_type");
+  MPI_Type_commit(&resized_type);
+
+  // Scatters the columns of a 4x4 matrix, consecutive columns overlap the span of the column type
+  MPI_Datatype column_type;
+  MPI_Type_vector(4, 1, 4, MPI_DOUBLE, &column_type);
+  MPI_Datatype scatter_type;
+  MPI_Type_create_resized(column_type, 0, sizeof(double), &scatter_type);
+  MPI_Type_set_name(scatter_type, "scatter_type");
+  MPI_Type_commit(&scatter_type);
+
+  double f[5];
+  padded_array<4> too_small;
+  S1 pair[2];
+  padded_array<16> matrix;
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[5]] against 1 element of MPI type "hvector_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[5]] against 1 element of MPI type "hvector_type"
+  // CHECK-NOT: R[{{0|1}}][Error]{{.*}}
+  // clang-format on
+  run_test(f, 1, hvector_type);
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x double[4]] against 1 element of MPI type "hvector_type": buffer too small (4 elements, 5 required)
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x double[4]] against 1 element of MPI type "hvector_type": buffer too small (4 elements, 5 required)
+  // clang-format on
+  run_test(too_small, 1, hvector_type);
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[5]] against 1 element of MPI type "indexed_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[5]] against 1 element of MPI type "indexed_type"
+  // clang-format on
+  run_test(f, 1, indexed_type);
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x double[4]] against 1 element of MPI type "hindexed_type": buffer too small (4 elements, 5 required)
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x double[4]] against 1 element of MPI type "hindexed_type": buffer too small (4 elements, 5 required)
+  // clang-format on
+  run_test(too_small, 1, hindexed_type);
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x S1[2]] against 2 elements of MPI type "resized_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x S1[2]] against 2 elements of MPI type "resized_type"
+  // clang-format on
+  run_test(pair, 2, resized_type);
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: internal error while checking send-buffer 0x{{.*}} of type [1 x double[16]] against 4 elements of MPI type "scatter_type": extents for MPI_Type_create_resized which differ from the span of the old type in the buffer are currently not supported
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: internal error while checking recv-buffer 0x{{.*}} of type [1 x double[16]] against 4 elements of MPI type "scatter_type": extents for MPI_Type_create_resized which differ from the span of the old type in the buffer are currently not supported
+  // clang-format on
+  run_test(matrix, 4, scatter_type);
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 6 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 6 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 1 Null_Buf: 0 Null_Count: 0 Type_Error: 2 }
+  MPI_Type_free(&scatter_type);
+  MPI_Type_free(&column_type);
+  MPI_Type_free(&resized_type);
+  MPI_Type_free(&s1_type);
+  MPI_Type_free(&hindexed_type);
+  MPI_Type_free(&indexed_type);
+  MPI_Type_free(&hvector_type);
+  MPI_Finalize();
+  return 0;
+}
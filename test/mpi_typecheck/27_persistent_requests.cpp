@@ -0,0 +1,80 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+constexpr auto n = 16;
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  auto* d = new double[n];
+  MPI_Request request;
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send_init: successfully checked send-buffer 0x{{.*}} of type [16 x double] against 16 elements of MPI type "MPI_DOUBLE"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv_init: successfully checked recv-buffer 0x{{.*}} of type [16 x double] against 16 elements of MPI type "MPI_DOUBLE"
+  // clang-format on
+  if (rank == 0) {
+    MPI_Send_init(d, n, MPI_DOUBLE, 1, 0, MPI_COMM_WORLD, &request);
+  } else {
+    MPI_Recv_init(d, n, MPI_DOUBLE, 0, 0, MPI_COMM_WORLD, &request);
+  }
+
+  // The verdict of the init call is current, starting the request does not check the buffer again
+  // clang-format off
+  // RANK0-NOT: MPI_Send_init: successfully checked
+  // RANK1-NOT: MPI_Recv_init: successfully checked
+  // clang-format on
+  for (int i = 0; i < 3; ++i) {
+    MPI_Start(&request);
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+  }
+
+  // Freeing another checked allocation does not outdate the verdict of the request
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [8 x int] against 8 elements of MPI type "MPI_INT"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [8 x int] against 8 elements of MPI type "MPI_INT"
+  // RANK0-NOT: MPI_Send_init: successfully checked
+  // RANK1-NOT: MPI_Recv_init: successfully checked
+  // clang-format on
+  auto* ints = new int[n / 2];
+  run_test(ints, n / 2, MPI_INT);
+  delete[] ints;
+  MPI_Startall(1, &request);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+  // Freeing an MPI type outdates the verdict of the request
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send_init: successfully checked send-buffer 0x{{.*}} of type [16 x double] against 16 elements of MPI type "MPI_DOUBLE"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv_init: successfully checked recv-buffer 0x{{.*}} of type [16 x double] against 16 elements of MPI type "MPI_DOUBLE"
+  // clang-format on
+  MPI_Datatype dup_type;
+  MPI_Type_dup(MPI_INT, &dup_type);
+  MPI_Type_free(&dup_type);
+  MPI_Start(&request);
+  MPI_Wait(&request, MPI_STATUS_IGNORE);
+
+  MPI_Request_free(&request);
+  delete[] d;
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 2 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 2 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 0 }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] PCounter { Start: 5 Revalidated: 1 }
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,41 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: TYPEART_REPORT=json %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+// Storage for the 4 doubles received, while the checked buffer has the type [4 x int], see padded_array
+struct padded_ints {
+  double offset;
+  int i[4];
+  double padding[2];
+};
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  double d[4];
+  padded_ints i;
+
+  for (int iteration = 0; iteration < 3; ++iteration) {
+    run_test(d, 4, MPI_DOUBLE);
+  }
+  run_test(i.i, 4, MPI_DOUBLE);
+
+  // The call sites of MPI_Send (rank 0) and MPI_Recv (rank 1) are in run_test, each rank calls only one of them
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] Report {"ranks":2,"call_sites":[{"function":"MPI_Recv","location":"{{.*}}","ranks":1,"calls":{"min":0,"max":4,"mean":2.00},"errors":{"min":0,"max":1,"mean":0.50},"check_time_us":{"min":0,"max":{{[0-9]+}},"mean":{{[0-9.]+}}}},{"function":"MPI_Send","location":"{{.*}}","ranks":1,"calls":{"min":0,"max":4,"mean":2.00},"errors":{"min":0,"max":1,"mean":0.50},"check_time_us":{"min":0,"max":{{[0-9]+}},"mean":{{[0-9.]+}}}}]}
+  // RANK1-NOT: Report
+  // clang-format on
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,43 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: TYPEART_OVERHEAD_BUDGET=0.000001 TYPEART_OVERHEAD_SAMPLING_RATE=4 %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+constexpr auto n = 16;
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  double f[n];
+
+  // The budget is exceeded after the first check, from then on every fourth call (i.e., calls 0, 4 and 8) is checked
+  // clang-format off
+  // RANK0-COUNT-3: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[16]] against 16 elements of MPI type "MPI_DOUBLE"
+  // RANK1-COUNT-3: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[16]] against 16 elements of MPI type "MPI_DOUBLE"
+  // CHECK-NOT: successfully checked
+  // clang-format on
+  for (int i = 0; i < 9; ++i) {
+    run_test(f, n, MPI_DOUBLE);
+  }
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 9 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 9 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] OCounter { Checks: 3 Check_Time[us]: {{[0-9]+}} Budget_Skipped: 6 }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 0 }
+  // RANK0: R[0]T[{{[0-9]*}}][Info] Timing { Function: MPI_Send Checks: 3 Time[us]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] Timing { Function: MPI_Recv Checks: 3 Time[us]: {{[0-9]+}} }
+  // RANK0: R[0]T[{{[0-9]*}}][Info] Sampling { Function: MPI_Send Sampled: 3 Skipped: 6 }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] Sampling { Function: MPI_Recv Sampled: 3 Skipped: 6 }
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,58 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+constexpr auto n = 16;
+
+// Storage for the n doubles received, while the checked buffer has the type [n x int], see padded_array
+struct padded_ints {
+  double offset;
+  int i[n];
+  double padding[n / 2];
+};
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  padded_ints i;
+
+  // Same call site, error kind and type pair in each iteration, only the first error is logged
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x int[16]] against 16 elements of MPI type "MPI_DOUBLE": expected a type matching MPI type "MPI_DOUBLE", but found type "int"
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x int[16]] against 16 elements of MPI type "MPI_DOUBLE": expected a type matching MPI type "MPI_DOUBLE", but found type "int"
+  // CHECK-NOT: [Error]
+  // clang-format on
+  for (int iteration = 0; iteration < 5; ++iteration) {
+    run_test(i.i, n, MPI_DOUBLE);
+  }
+
+  // A different type pair at the same call site is logged
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x int[16]] against 16 elements of MPI type "MPI_FLOAT": expected a type matching MPI type "MPI_FLOAT", but found type "int"
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x int[16]] against 16 elements of MPI type "MPI_FLOAT": expected a type matching MPI type "MPI_FLOAT", but found type "int"
+  // CHECK-NOT: [Error]
+  // clang-format on
+  run_test(i.i, n, MPI_FLOAT);
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 6 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 6 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 6 }
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] Repeated error (5 occurrences): at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x int[16]] against 16 elements of MPI type "MPI_DOUBLE"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] Repeated error (5 occurrences): at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x int[16]] against 16 elements of MPI type "MPI_DOUBLE"
+  // clang-format on
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] ECounter { Unique: 2 Total: 6 }
+  MPI_Finalize();
+  return 0;
+}
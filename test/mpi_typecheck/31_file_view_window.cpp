@@ -0,0 +1,84 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include <mpi.h>
+#include <string>
+
+constexpr auto n = 16;
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  auto* d    = new double[n];
+  auto* ints = new int[n];
+
+  MPI_Datatype four_doubles;
+  MPI_Type_contiguous(4, MPI_DOUBLE, &four_doubles);
+  MPI_Type_set_name(four_doubles, "four_doubles");
+  MPI_Type_commit(&four_doubles);
+
+  const auto file_name = "31_file_view_window." + std::to_string(rank) + ".dat";
+  MPI_File fh;
+  MPI_File_open(MPI_COMM_SELF, file_name.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY | MPI_MODE_DELETE_ON_CLOSE,
+                MPI_INFO_NULL, &fh);
+
+  // clang-format off
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_File_set_view: successfully checked MPI type "MPI_DOUBLE" against the file view of "MPI_DOUBLE" elements
+  // clang-format on
+  MPI_File_set_view(fh, 0, MPI_DOUBLE, MPI_DOUBLE, "native", MPI_INFO_NULL);
+
+  // The second write only looks up the memoized signature of MPI_DOUBLE
+  // clang-format off
+  // CHECK-COUNT-2: R[{{0|1}}]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_File_write: successfully checked MPI type "MPI_DOUBLE" against the file view of "MPI_DOUBLE" elements
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_File_write: successfully checked MPI type "four_doubles" against the file view of "MPI_DOUBLE" elements
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_File_write: type error while checking MPI type "MPI_INT" against the file view of "MPI_DOUBLE" elements: expected elements of MPI type "MPI_DOUBLE", but found elements of MPI type "MPI_INT"
+  // clang-format on
+  for (int i = 0; i < 2; ++i) {
+    MPI_File_write(fh, d, n, MPI_DOUBLE, MPI_STATUS_IGNORE);
+  }
+  MPI_File_write(fh, d, n / 4, four_doubles, MPI_STATUS_IGNORE);
+  MPI_File_write(fh, ints, n, MPI_INT, MPI_STATUS_IGNORE);
+
+  MPI_File_close(&fh);
+
+  MPI_Win win;
+  MPI_Win_create(d, n * sizeof(double), sizeof(double), MPI_INFO_NULL, MPI_COMM_WORLD, &win);
+  MPI_Win_fence(0, win);
+
+  // clang-format off
+  // RANK0-COUNT-3: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Put: successfully checked target window 0x{{.*}} of type [16 x double] against MPI type "MPI_DOUBLE"
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Put: type error while checking target window 0x{{.*}} of type [16 x double] against MPI type "MPI_INT": expected a type matching MPI type "MPI_INT", but found type "double"
+  // clang-format on
+  if (rank == 0) {
+    for (int i = 0; i < 3; ++i) {
+      MPI_Put(d, n, MPI_DOUBLE, 1, 0, n, MPI_DOUBLE, win);
+    }
+    MPI_Put(ints, n, MPI_INT, 1, 0, n, MPI_INT, win);
+  }
+
+  MPI_Win_fence(0, win);
+  MPI_Win_free(&win);
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 8 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 4 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK0: R[0]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 2 }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 1 }
+  // RANK0: R[0]T[{{[0-9]*}}][Info] FCounter { View_Hit: 1 View_Miss: 3 Window_Hit: 2 Window_Miss: 2 }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] FCounter { View_Hit: 1 View_Miss: 3 Window_Hit: 0 Window_Miss: 0 }
+  MPI_Type_free(&four_doubles);
+  delete[] d;
+  delete[] ints;
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,64 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  // A single process owns the whole 2 x 4 global array
+  MPI_Datatype mpi_darray;
+  MPI_Type_create_darray(1, 0, 2, (int[]){2, 4}, (int[]){MPI_DISTRIBUTE_BLOCK, MPI_DISTRIBUTE_BLOCK},
+                         (int[]){MPI_DISTRIBUTE_DFLT_DARG, MPI_DISTRIBUTE_DFLT_DARG}, (int[]){1, 1}, MPI_ORDER_C,
+                         MPI_DOUBLE, &mpi_darray);
+  MPI_Type_set_name(mpi_darray, "test_type");
+  MPI_Type_commit(&mpi_darray);
+
+  MPI_Datatype mpi_int_darray;
+  MPI_Type_create_darray(1, 0, 2, (int[]){2, 4}, (int[]){MPI_DISTRIBUTE_BLOCK, MPI_DISTRIBUTE_BLOCK},
+                         (int[]){MPI_DISTRIBUTE_DFLT_DARG, MPI_DISTRIBUTE_DFLT_DARG}, (int[]){1, 1}, MPI_ORDER_C,
+                         MPI_INT, &mpi_int_darray);
+  MPI_Type_set_name(mpi_int_darray, "int_type");
+  MPI_Type_commit(&mpi_int_darray);
+
+  double f[8];
+  padded_array<7> too_small;
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[8]] against 1 element of MPI type "test_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[8]] against 1 element of MPI type "test_type"
+  // CHECK-NOT: R[{{0|1}}][Error]{{.*}}
+  // clang-format on
+  run_test(f, 1, mpi_darray);
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x double[7]] against 1 element of MPI type "test_type": buffer too small (7 elements, 8 required)
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x double[7]] against 1 element of MPI type "test_type": buffer too small (7 elements, 8 required)
+  // clang-format on
+  run_test(too_small, 1, mpi_darray);
+
+  // The 8 ints fit into the buffer of 8 doubles
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x double[8]] against 1 element of MPI type "int_type": expected a type matching MPI type "MPI_INT", but found type "double"
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x double[8]] against 1 element of MPI type "int_type": expected a type matching MPI type "MPI_INT", but found type "double"
+  // clang-format on
+  run_test(f, 1, mpi_int_darray);
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 3 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 3 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 2 }
+  MPI_Type_free(&mpi_int_darray);
+  MPI_Type_free(&mpi_darray);
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,72 @@
+// REQUIRES: mpi
+// UNSUPPORTED: asan
+// UNSUPPORTED: tsan
+// clang-format off
+// RUN: %run %s --mpi_intercept --compile_flags "-g" --executable %s.exe --command "%mpi-exec -n 2 --output-filename %s.log %s.exe"
+// RUN: cat "%s.log/1/rank.0/stderr" | %filecheck --check-prefixes CHECK,RANK0 %s
+// RUN: cat "%s.log/1/rank.1/stderr" | %filecheck --check-prefixes CHECK,RANK1 %s
+// clang-format on
+
+#include "Util.hpp"
+
+#include <mpi.h>
+
+int main(int argc, char** argv) {
+  MPI_Init(&argc, &argv);
+
+  // CHECK: [Trace] TypeART Runtime Trace
+
+  MPI_Datatype mpi_hindexed_block;
+  MPI_Type_create_hindexed_block(2, 2, (MPI_Aint[]){3 * sizeof(double), 0}, MPI_DOUBLE, &mpi_hindexed_block);
+  MPI_Type_set_name(mpi_hindexed_block, "test_type");
+  MPI_Type_commit(&mpi_hindexed_block);
+
+  MPI_Datatype mpi_int_hindexed_block;
+  MPI_Type_create_hindexed_block(2, 2, (MPI_Aint[]){3 * sizeof(int), 0}, MPI_INT, &mpi_int_hindexed_block);
+  MPI_Type_set_name(mpi_int_hindexed_block, "int_type");
+  MPI_Type_commit(&mpi_int_hindexed_block);
+
+  MPI_Datatype mpi_empty_hindexed_block;
+  MPI_Type_create_hindexed_block(0, 5, (MPI_Aint[]){0}, MPI_DOUBLE, &mpi_empty_hindexed_block);
+  MPI_Type_set_name(mpi_empty_hindexed_block, "empty_type");
+  MPI_Type_commit(&mpi_empty_hindexed_block);
+
+  double f[5];
+  padded_array<4> too_small;
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[5]] against 1 element of MPI type "test_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[5]] against 1 element of MPI type "test_type"
+  // CHECK-NOT: R[{{0|1}}][Error]{{.*}}
+  // clang-format on
+  run_test(f, 1, mpi_hindexed_block);
+
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x double[4]] against 1 element of MPI type "test_type": buffer too small (4 elements, 5 required)
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x double[4]] against 1 element of MPI type "test_type": buffer too small (4 elements, 5 required)
+  // clang-format on
+  run_test(too_small, 1, mpi_hindexed_block);
+
+  // The 5 ints fit into the buffer of 5 doubles
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Send: type error while checking send-buffer 0x{{.*}} of type [1 x double[5]] against 1 element of MPI type "int_type": expected a type matching MPI type "MPI_INT", but found type "double"
+  // RANK1: R[1]T[{{[0-9]*}}][Error] at 0x{{.*}}: MPI_Recv: type error while checking recv-buffer 0x{{.*}} of type [1 x double[5]] against 1 element of MPI type "int_type": expected a type matching MPI type "MPI_INT", but found type "double"
+  // clang-format on
+  run_test(f, 1, mpi_int_hindexed_block);
+
+  // An empty type requires no elements, regardless of its blocklength
+  // clang-format off
+  // RANK0: R[0]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Send: successfully checked send-buffer 0x{{.*}} of type [1 x double[4]] against 1 element of MPI type "empty_type"
+  // RANK1: R[1]T[{{[0-9]*}}][Info] at 0x{{.*}}: MPI_Recv: successfully checked recv-buffer 0x{{.*}} of type [1 x double[4]] against 1 element of MPI type "empty_type"
+  // clang-format on
+  run_test(too_small, 1, mpi_empty_hindexed_block);
+
+  // RANK0: R[0]T[{{[0-9]*}}][Info] CCounter { Send: 4 Recv: 0 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // RANK1: R[1]T[{{[0-9]*}}][Info] CCounter { Send: 0 Recv: 4 Send_Recv: 0 Unsupported: 0 MAX RSS[KBytes]: {{[0-9]+}} }
+  // CHECK: R[{{0|1}}]T[{{[0-9]*}}][Info] MCounter { Error: 0 Null_Buf: 0 Null_Count: 0 Type_Error: 2 }
+  MPI_Type_free(&mpi_empty_hindexed_block);
+  MPI_Type_free(&mpi_int_hindexed_block);
+  MPI_Type_free(&mpi_hindexed_block);
+  MPI_Finalize();
+  return 0;
+}
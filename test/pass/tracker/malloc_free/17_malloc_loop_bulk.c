@@ -0,0 +1,40 @@
+// clang-format off
+// RUN: %c-to-llvm %s | %apply-typeart -typeart-heap-bulk -S 2>&1 | %filecheck %s
+// REQUIRES: tracker
+// clang-format on
+
+#include <stdlib.h>
+
+void foo(double** x, int n) {
+  for (int i = 0; i < n; ++i) {
+    x[i] = (double*)malloc(8 * sizeof(double));
+  }
+}
+
+void bar(double** x, int n) {
+  for (int i = 0; i < n; ++i) {
+    x[i] = (double*)malloc(8 * sizeof(double));
+    free(x[i]);
+  }
+}
+// clang-format off
+
+// CHECK: define {{.*}}void @foo
+// CHECK: __ta_bulk_addrs = alloca [64 x i8*]
+// CHECK: [[POINTER:%[0-9a-z]+]] = call noalias{{( align [0-9]+)?}} i8* @malloc
+// CHECK-NOT: call void @typeart_tracker_alloc(
+// CHECK: store i8* [[POINTER]], i8**
+// CHECK: call void @typeart_tracker_alloc_bulk(i8** {{.*}}, i32 {{[0-9]*}}, i64* {{.*}}, i64 {{.*}})
+// CHECK: call void @typeart_tracker_alloc_bulk(i8** {{.*}}, i32 {{[0-9]*}}, i64* {{.*}}, i64 {{.*}})
+
+// The loop contains a free, the allocation is registered individually:
+// CHECK: define {{.*}}void @bar
+// CHECK-NOT: __ta_bulk_addrs
+// CHECK: [[POINTER:%[0-9a-z]+]] = call noalias{{( align [0-9]+)?}} i8* @malloc
+// CHECK-NEXT: call void @typeart_tracker_alloc(i8* [[POINTER]], i32 {{[0-9]*}}, i64 8)
+
+// CHECK: TypeArtPass [Heap & Stack]
+// CHECK-NEXT: Malloc{{[ ]*}}:{{[ ]*}}2
+// CHECK-NEXT: Free{{[ ]*}}:{{[ ]*}}1
+
+// clang-format on
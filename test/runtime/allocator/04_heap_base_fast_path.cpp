@@ -0,0 +1,38 @@
+// RUN: %run %s 2>&1 | %filecheck %s
+// REQUIRES: allocator
+
+#include "../tracker/util.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+struct Point {
+  double x;
+  double y;
+};
+
+int main(int argc, char** argv) {
+  double* d = (double*)malloc(10 * sizeof(double));
+  Point* p  = (Point*)malloc(3 * sizeof(Point));
+
+  // Exact base addresses
+  // CHECK: Ok
+  check(d, "double", 10, false);
+  // CHECK: Ok
+  check_struct(p, "Point", 3);
+
+  // Interior addresses take the general path
+  // CHECK: Ok
+  check(&d[4], "double", 6, false);
+  // CHECK: Ok
+  check(&p[1].y, "double", 1, false);
+
+  // Updated count after an in-place realloc
+  d = (double*)realloc(d, 12 * sizeof(double));
+  // CHECK: Ok
+  check(d, "double", 12, false);
+
+  free(p);
+  free(d);
+  return 0;
+}
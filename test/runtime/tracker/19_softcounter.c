@@ -26,12 +26,14 @@ int main(void) {
 // CHECK-NEXT: Addresses re-used          :   0 ,    - ,    -
 // CHECK-NEXT: Addresses missed           :   0 ,    - ,    -
 // CHECK-NEXT: Distinct Addresses missed  :   0 ,    - ,    -
+// CHECK-NEXT: Lookup cache hit/miss      :   0 ,    0 ,    -
+// CHECK-NEXT: Subtype memo hit/miss      :   0 ,    0 ,    -
 // CHECK-NEXT: Total free heap            :   5 ,    4 ,    -
 // CHECK-NEXT: Total free stack           :   0 ,    0 ,    -
 // CHECK-NEXT: OMP Stack/Heap/Free        :   0 ,    0 ,    0
 // CHECK-NEXT: Null/Zero/NullZero Addr    :   0 ,    0 ,    0
 // CHECK-NEXT: Estimated memory use (KiB) :   4 ,    - ,    -
-// CHECK-NEXT: Bytes per node map/stack   :  104 ,    8 ,    -
+// CHECK-NEXT: Bytes per node map/stack   :   88 ,    8 ,    -
 // CHECK-NEXT: {{(#|-)+}}
 // CHECK-NEXT: Allocation type detail (heap, stack, global)
 // CHECK-NEXT: double :   5 ,    0 ,    0
@@ -0,0 +1,36 @@
+// RUN: %run %s 2>&1 | %filecheck %s
+// REQUIRES: tracker
+
+#include "util.hpp"
+
+#include <stdlib.h>
+
+using namespace typeart;
+
+int main(int argc, char** argv) {
+  auto meta_id = create_fake_double_heap_allocation().value();
+
+  // Fake address, the memory is never accessed.
+  auto* addr = (double*)0x1000;
+
+  typeart_tracker_alloc(addr, meta_id, 4);
+  // CHECK: Ok
+  check(&addr[1], "double", 3, false);
+  // Second lookup is served from the cache
+  // CHECK: Ok
+  check(&addr[1], "double", 3, false);
+
+  // A re-allocation at the same address must not be answered with the stale cache entry
+  typeart_tracker_free(addr);
+  typeart_tracker_alloc(addr, meta_id, 2);
+  // CHECK: Ok
+  check(&addr[1], "double", 1, false);
+
+  typeart_tracker_free(addr);
+  // CHECK: Error: Unknown address
+  check(&addr[1], "double", 1, false);
+
+  return 0;
+}
+
+// CHECK-NOT: Error
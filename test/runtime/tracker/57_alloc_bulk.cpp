@@ -0,0 +1,41 @@
+// RUN: %run %s 2>&1 | %filecheck %s
+// REQUIRES: tracker
+
+#include "util.hpp"
+
+#include <stdlib.h>
+
+using namespace typeart;
+
+int main(int argc, char** argv) {
+  auto meta_id = create_fake_double_heap_allocation().value();
+
+  // Fake addresses (unsorted), the memory is never accessed.
+  const void* addrs[3] = {(double*)0x3000, (double*)0x1000, (double*)0x2000};
+  size_t counts[3]     = {3, 1, 2};
+
+  typeart_tracker_alloc_bulk(addrs, meta_id, counts, 3);
+  // CHECK: Ok
+  check((double*)0x1000, "double", 1, false);
+  // CHECK: Ok
+  check(&((double*)0x2000)[1], "double", 1, false);
+  // CHECK: Ok
+  check((double*)0x3000, "double", 3, false);
+
+  // Overriding an existing entry is reported as address reuse
+  const void* reused[1]  = {(double*)0x2000};
+  size_t reused_count[1] = {4};
+  typeart_tracker_alloc_bulk(reused, meta_id, reused_count, 1);
+  // CHECK: Ok
+  check((double*)0x2000, "double", 4, false);
+
+  for (auto* addr : addrs) {
+    typeart_tracker_free(addr);
+  }
+  // CHECK: Error: Unknown address
+  check((double*)0x1000, "double", 1, false);
+
+  return 0;
+}
+
+// CHECK-NOT: Error
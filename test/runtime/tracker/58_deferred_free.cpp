@@ -0,0 +1,52 @@
+// RUN: TYPEART_DEFERRED_FREE=1 %run %s 2>&1 | %filecheck %s
+// REQUIRES: tracker
+
+#include "util.hpp"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+using namespace typeart;
+
+int main(int argc, char** argv) {
+  auto meta_id = create_fake_double_heap_allocation().value();
+
+  // Fake address, the memory is never accessed.
+  auto* addr = (double*)0x1000;
+
+  typeart_tracker_alloc(addr, meta_id, 4);
+  // CHECK: Ok
+  check(addr, "double", 4, false);
+
+  // The lookup applies the pending free
+  typeart_tracker_free(addr);
+  // CHECK: Error: Unknown address
+  check(addr, "double", 4, false);
+
+  // The pending free must be applied before the address is registered again
+  typeart_tracker_alloc(addr, meta_id, 4);
+  typeart_tracker_free(addr);
+  typeart_tracker_alloc(addr, meta_id, 2);
+  // CHECK: Ok
+  check(&addr[1], "double", 1, false);
+
+  // More frees than the queue holds
+  for (uintptr_t i = 1; i <= 1000; ++i) {
+    typeart_tracker_alloc((double*)(0x10000 + i * 64), meta_id, 8);
+  }
+  for (uintptr_t i = 1; i <= 1000; ++i) {
+    typeart_tracker_free((double*)(0x10000 + i * 64));
+  }
+  // CHECK: Ok
+  check(&addr[1], "double", 1, false);
+
+  typeart_tracker_free(addr);
+  // CHECK: Error: Unknown address
+  check(addr, "double", 2, false);
+  // CHECK: Error: Unknown address
+  check((double*)(0x10000 + 500 * 64), "double", 8, false);
+
+  return 0;
+}
+
+// CHECK-NOT: Error
@@ -0,0 +1,36 @@
+// clang-format off
+// RUN: TYPEART_OMPT=1 %run %s --omp 2>&1 | %filecheck %s
+// REQUIRES: openmp
+// REQUIRES: tracker
+// clang-format on
+
+void g(int i) {
+  double d[2];
+  d[0] = i;
+  // Suspended (untied) tasks may be resumed on another thread
+#pragma omp taskyield
+  d[1] = i;
+}
+
+int main(int argc, char** argv) {
+  // CHECK: [Trace] TypeART Runtime Trace
+#pragma omp parallel
+#pragma omp single
+  {
+    for (int i = 0; i < 16; ++i) {
+#pragma omp task untied
+      {
+        int x[3];
+        x[0] = i;
+        g(i);
+      }
+    }
+#pragma omp taskwait
+  }
+
+  // CHECK-NOT: Stack is smaller than requested de-allocation count
+  // CHECK-NOT: Error
+
+  // CHECK: [Trace] Free stack 0x{{.*}} of type [1 x double[2]]
+  return 0;
+}
@@ -0,0 +1,92 @@
+// RUN: %run %s 2>&1 | %filecheck %s
+// REQUIRES: tracker
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <typeart/TypeART.hpp>
+
+struct Inner {
+  int a;
+  double b[3];
+};
+
+struct Base {
+  float f;
+};
+
+struct Outer : Base {
+  Inner inner;
+  Inner inners[4];
+  char c;
+};
+
+void check(const void* addr, const char* type_name, size_t count) {
+  auto pointer_info_result = typeart::PointerInfo::get(addr);
+  if (pointer_info_result.has_error()) {
+    fprintf(stderr, "Error: Unknown address\n");
+    return;
+  }
+  auto resolved = pointer_info_result.value().resolveOffsetFast(typeart::pointer{addr});
+  if (resolved.has_error()) {
+    std::cerr << "Error: Status " << resolved.error() << "\n";
+    return;
+  }
+  const auto pretty_name = resolved.value().getType().get_pretty_name();
+  if (pretty_name != type_name || resolved.value().getCount() != count ||
+      resolved.value().getBaseAddr().get() != addr) {
+    fprintf(stderr, "Error: Mismatch %s %zu\n", pretty_name.c_str(), resolved.value().getCount());
+    return;
+  }
+  fprintf(stderr, "Ok\n");
+}
+
+void check_path(const void* base, const void* addr) {
+  auto pointer_info_result = typeart::PointerInfo::get(base);
+  if (pointer_info_result.has_error()) {
+    fprintf(stderr, "Error: Unknown address\n");
+    return;
+  }
+  typeart::member_path path;
+  auto resolved = pointer_info_result.value().resolveOffsetFast(typeart::pointer{addr}, path);
+  if (resolved.has_error()) {
+    std::cerr << "Error: Status " << resolved.error() << "\n";
+    return;
+  }
+  std::cerr << "Path:";
+  for (const auto* member : path) {
+    std::cerr << " " << member->get_name();
+  }
+  std::cerr << "\n";
+}
+
+int main(int argc, char** argv) {
+  Outer* o = (Outer*)malloc(2 * sizeof(Outer));
+
+  // CHECK: Ok
+  check(&o[1].inner.b[1], "double", 2);
+  // CHECK: Ok
+  check(&o[0].inners[2].b[0], "double", 3);
+  // CHECK: Ok
+  check(&o[1].inners[3].a, "int", 1);
+  // CHECK: Ok
+  check(&o[0].c, "char", 1);
+  // Base class member
+  // CHECK: Ok
+  check(&o[1].f, "float", 1);
+
+  // Members accessed from the allocation, including the member at offset 0 of the innermost structure
+  // CHECK: Path: inners b
+  check_path(o, &o[1].inners[2].b[0]);
+  // CHECK: Path: inner a
+  check_path(o, &o[0].inner);
+  // CHECK: Path: f
+  check_path(o, &o[1].f);
+
+  // Within a double
+  // CHECK: Error: Status BAD_ALIGNMENT
+  check(((char*)&o[0].inner.b[1]) + 1, "double", 1);
+
+  free(o);
+  return 0;
+}
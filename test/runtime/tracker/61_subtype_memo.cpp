@@ -0,0 +1,62 @@
+// RUN: %run %s 2>&1 | %filecheck %s
+// REQUIRES: tracker
+
+#include <cstddef>
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <typeart/TypeART.hpp>
+
+struct Cell {
+  int id;
+  double values[3];
+};
+
+struct Row {
+  Cell cells[4];
+};
+
+int check(const void* addr, const char* type_name, size_t count) {
+  auto pointer_info_result = typeart::PointerInfo::get(addr);
+  if (pointer_info_result.has_error()) {
+    std::cerr << "Error: Status " << pointer_info_result.error() << "\n";
+    return 1;
+  }
+  const auto& info       = pointer_info_result.value();
+  const auto pretty_name = info.getType().get_pretty_name();
+  if (pretty_name != type_name || info.getCount() != count || info.getBaseAddr().get() != addr) {
+    fprintf(stderr, "Error: Mismatch %s %zu\n", pretty_name.c_str(), info.getCount());
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  const int rows = 8;
+  Row* grid      = (Row*)malloc(rows * sizeof(Row));
+
+  // Same (type, offset) pairs in every row, resolved from the memo after the first row
+  int errors = 0;
+  for (int i = 0; i < rows; ++i) {
+    errors += check(&grid[i].cells[1].values[1], "double", 2);
+    errors += check(&grid[i].cells[2], "Cell", 2);
+    errors += check(&grid[i].cells[3].values[2], "double", 1);
+  }
+  // CHECK: Errors: 0
+  fprintf(stderr, "Errors: %d\n", errors);
+
+  // The member containing a memoized offset is taken from the member path
+  auto row_info    = typeart::PointerInfo::get(&grid[2]).value();
+  auto member_info = row_info.findMember(typeart::byte_offset::from_bytes(offsetof(Row, cells[1].values[1])));
+  // CHECK: Member: 1
+  fprintf(stderr, "Member: %d\n", member_info.has_value() && member_info.value().getBaseAddr().get() == grid[2].cells);
+
+  // Memoized failures
+  // CHECK: Error: Status BAD_ALIGNMENT
+  check(((char*)&grid[1].cells[0].values[0]) + 1, "double", 1);
+  // CHECK: Error: Status BAD_ALIGNMENT
+  check(((char*)&grid[5].cells[0].values[0]) + 1, "double", 1);
+
+  free(grid);
+  return 0;
+}
@@ -0,0 +1,48 @@
+// RUN: %run %s 2>&1 | %filecheck %s
+// REQUIRES: tracker
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <typeart/TypeART.hpp>
+
+struct First {
+  int a;
+};
+
+struct Second {
+  double b[2];
+};
+
+struct Derived : First, Second {
+  char c;
+};
+
+void check(const void* addr, const char* type_name, size_t count) {
+  auto pointer_info_result = typeart::PointerInfo::get(addr);
+  if (pointer_info_result.has_error()) {
+    fprintf(stderr, "Error: Status %d\n", static_cast<int>(pointer_info_result.error()));
+    return;
+  }
+  const auto& info       = pointer_info_result.value();
+  const auto pretty_name = info.getType().get_pretty_name();
+  if (pretty_name != type_name || info.getCount() != count || info.getBaseAddr().get() != addr) {
+    fprintf(stderr, "Error: Mismatch %s %zu\n", pretty_name.c_str(), info.getCount());
+    return;
+  }
+  fprintf(stderr, "Ok\n");
+}
+
+int main(int argc, char** argv) {
+  Derived* d = (Derived*)malloc(3 * sizeof(Derived));
+
+  // Member of a base class at a non-zero offset
+  // CHECK: Ok
+  check(&d[1].b[1], "double", 1);
+  // CHECK: Ok
+  check(&d[2].c, "char", 1);
+  // CHECK: Ok
+  check(&d[0].a, "Derived", 3);
+
+  free(d);
+  return 0;
+}
@@ -0,0 +1,64 @@
+// RUN: %run %s 2>&1 | %filecheck %s
+// REQUIRES: tracker
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <typeart/TypeART.hpp>
+#include <typeart/runtime/RuntimeInterface.h>
+
+struct Pair {
+  int a;
+  double b;
+};
+
+int main(int argc, char** argv) {
+  double* d = (double*)malloc(16 * sizeof(double));
+  Pair* p   = (Pair*)malloc(4 * sizeof(Pair));
+  int* i    = (int*)malloc(8 * sizeof(int));
+  const void* unknown = reinterpret_cast<const void*>(0x1);
+
+  // Unsorted, with duplicates and an unknown address
+  const void* addrs[] = {&i[3], &p[2].b, d, unknown, &d[15], &i[3], &p[0]};
+  const size_t n      = sizeof(addrs) / sizeof(addrs[0]);
+
+  cpp::result<typeart::PointerInfo, typeart::Status> results[n];
+  typeart::PointerInfo::get_batch(addrs, n, results);
+  for (size_t k = 0; k < n; ++k) {
+    auto single = typeart::PointerInfo::get(addrs[k]);
+    if (single.has_error() != results[k].has_error()) {
+      fprintf(stderr, "Error: Mismatch at %zu\n", k);
+      continue;
+    }
+    if (single.has_error()) {
+      fprintf(stderr, "Status %d\n", static_cast<int>(results[k].error()));
+      continue;
+    }
+    fprintf(stderr, "%s %zu %d\n", results[k].value().getType().get_pretty_name().c_str(), results[k].value().getCount(),
+            single.value().getBaseAddr() == results[k].value().getBaseAddr());
+  }
+  // CHECK: int 5 1
+  // CHECK-NEXT: double 1 1
+  // CHECK-NEXT: double 16 1
+  // CHECK-NEXT: Status 1
+  // CHECK-NEXT: double 1 1
+  // CHECK-NEXT: int 5 1
+  // CHECK-NEXT: Pair 4 1
+
+  typeart_type_info infos[n];
+  typeart_status statuses[n];
+  typeart_get_types(addrs, n, infos, statuses);
+  size_t ok{0};
+  for (size_t k = 0; k < n; ++k) {
+    if (statuses[k] == TYPEART_OK && infos[k].count == results[k].value().getCount() &&
+        infos[k].type_id == results[k].value().getType().get_id().value()) {
+      ++ok;
+    }
+  }
+  // CHECK: C interface: 6 ok, unknown 1
+  fprintf(stderr, "C interface: %zu ok, unknown %d\n", ok, statuses[3] == TYPEART_UNKNOWN_ADDRESS);
+
+  free(i);
+  free(p);
+  free(d);
+  return 0;
+}
@@ -0,0 +1,46 @@
+// RUN: %run %s 2>&1 | %filecheck %s
+// REQUIRES: tracker
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <typeart/runtime/RuntimeInterface.h>
+
+struct Pair {
+  int a;
+  double b;
+};
+
+void print(const void* addr) {
+  typeart_type_info info;
+  typeart_status status = typeart_get_type(addr, &info);
+  if (status != TYPEART_OK) {
+    fprintf(stderr, "Status %d\n", (int)status);
+    return;
+  }
+  fprintf(stderr, "offset %zu count %zu size %zu\n", info.offset, info.count, info.element_size);
+}
+
+int main(void) {
+  double* d      = (double*)malloc(16 * sizeof(double));
+  struct Pair* p = (struct Pair*)malloc(4 * sizeof(struct Pair));
+
+  // CHECK: offset 0 count 16 size 8
+  print(d);
+  // CHECK: offset 40 count 11 size 8
+  print(&d[5]);
+  // CHECK: offset 24 count 1 size 8
+  print(&p[1].b);
+  // CHECK: offset 32 count 2 size 16
+  print(&p[2]);
+  // CHECK: Status 2
+  print(((char*)&d[1]) + 1);
+
+  typeart_type_info info;
+  typeart_get_type(&d[2], &info);
+  // CHECK: base 1
+  fprintf(stderr, "base %d\n", info.base_addr == d);
+
+  free(p);
+  free(d);
+  return 0;
+}
@@ -0,0 +1,79 @@
+// clang-format off
+// RUN: %run %s --thread 2>&1 | %filecheck %s
+// REQUIRES: thread
+// REQUIRES: tracker
+// clang-format on
+
+#include "util.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace typeart;
+
+constexpr std::uint64_t rounds = 2000;
+constexpr unsigned readers     = 3;
+
+// The round and whether the allocation of the round is currently registered (lowest bit).
+std::atomic<std::uint64_t> state{0};
+std::atomic<unsigned> validated{0};
+std::atomic<unsigned> errors{0};
+
+// Fake address, the memory is never accessed.
+auto* const addr = (double*)0x1000;
+
+size_t count_of(std::uint64_t round) {
+  return 2 + round % 5;
+}
+
+void lookup() {
+  while (true) {
+    const auto before = state.load();
+    if (before == ~std::uint64_t{0}) {
+      return;
+    }
+    auto result      = PointerInfo::get(&addr[1]);
+    const auto after = state.load();
+    // Only lookups while the same allocation was registered throughout are validated. Stale lookup cache entries of
+    // an earlier round (e.g., of a lookup racing the free) must not be returned.
+    if (before != after || (before & 1U) == 0) {
+      continue;
+    }
+    if (result.has_error() || result.value().getCount() != count_of(before >> 1U) - 1) {
+      ++errors;
+    }
+    ++validated;
+  }
+}
+
+int main(int argc, char** argv) {
+  auto meta_id = create_fake_double_heap_allocation().value();
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < readers; ++i) {
+    threads.emplace_back(lookup);
+  }
+
+  for (std::uint64_t round = 1; round <= rounds; ++round) {
+    typeart_tracker_alloc(addr, meta_id, count_of(round));
+    validated = 0;
+    state     = (round << 1U) | 1U;
+    while (validated < readers) {
+      std::this_thread::yield();
+    }
+    state = round << 1U;
+    typeart_tracker_free(addr);
+  }
+  state = ~std::uint64_t{0};
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // CHECK: Errors: 0
+  fprintf(stderr, "Errors: %u\n", errors.load());
+
+  return 0;
+}
@@ -12,6 +12,7 @@ void typeart_tracker_alloc(const void* addr, meta_id_value alloc_id, size_t coun
 void typeart_tracker_free(const void* addr);
 void typeart_tracker_alloc_stack(const void* addr, meta_id_value alloc_id, size_t count);
 void typeart_tracker_leave_scope(int alloca_count);
+void typeart_tracker_alloc_bulk(const void** addrs, meta_id_value alloc_id, const size_t* counts, size_t n);
 }
 namespace typeart {
 meta::Database& getDatabase();